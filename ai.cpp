@@ -19,16 +19,16 @@
 
 #include "ai.hpp"
 
-GoodInfo::GoodInfo(unsigned int fId, bool ond)
-    : fullId(fId), owned(ond), limitFactor(Settings::aILimitFactor()), min(std::numeric_limits<double>::max()),
-      max(0), estimate(0), buy(0), sell(std::numeric_limits<double>::max()) {}
+GoodInfo::GoodInfo(unsigned int fId)
+    : fullId(fId), limitFactor(Settings::aILimitFactor()), min(std::numeric_limits<double>::max()), max(0),
+      estimate(0), buy(0), sell(std::numeric_limits<double>::max()) {}
 
 GoodInfo::GoodInfo(const Save::GoodInfo *ldGdInf)
-    : fullId(ldGdInf->fullId()), owned(ldGdInf->owned()), limitFactor(ldGdInf->limitFactor()), min(ldGdInf->min()),
-      max(ldGdInf->max()), estimate(ldGdInf->estimate()), buy(ldGdInf->buy()), sell(ldGdInf->sell()) {}
+    : fullId(ldGdInf->fullId()), limitFactor(ldGdInf->limitFactor()), min(ldGdInf->min()), max(ldGdInf->max()),
+      estimate(ldGdInf->estimate()), buy(ldGdInf->buy()), sell(ldGdInf->sell()) {}
 
-Save::GoodInfo GoodInfo::save() const {
-    return Save::GoodInfo(fullId, owned, limitFactor, min, max, estimate, buy, sell);
+Save::GoodInfo GoodInfo::save(bool ond) const {
+    return Save::GoodInfo(fullId, ond, limitFactor, min, max, estimate, buy, sell);
 }
 
 void GoodInfo::appraise(double tnPft) {
@@ -37,41 +37,78 @@ void GoodInfo::appraise(double tnPft) {
     sell = estimate / tnPft;
 }
 
-AI::AI(Traveler &tvl, const EnumArray<double, DecisionCriteria> &dcC, const GoodInfoContainer &gsI, AIRole rl)
+AI::AI(Traveler &tvl, const std::shared_ptr<const EnumArray<double, DecisionCriteria>> &dcC,
+       const std::shared_ptr<std::vector<GoodInfo>> &gsI, const boost::dynamic_bitset<> &knn,
+       const boost::dynamic_bitset<> &ond, AIRole rl)
     : traveler(tvl), decisionCounter(Settings::aIDecisionCounter()),
-      businessCounter(Settings::aIBusinessCounter()), decisionCriteria(dcC), goodsInfo(gsI), role(rl) {
+      businessCounter(Settings::aIBusinessCounter()), decisionCriteria(dcC), goodsInfo(gsI), known(knn), owned(ond),
+      role(rl) {
     auto town = traveler.town();
     if (role >= AIRole::agent) traveler.setHome();
     auto &townProperty = town->getProperty();
     traveler.createAIGoods(role);
     // Insert full ids of owned goods into goods info.
-    for (auto fId : traveler.property().fullIds()) goodsInfo.emplace(fId, true);
-    if (gsI.empty())
+    for (auto fId : traveler.property().fullIds()) knowGood(fId, true);
+    if (knn.none())
         // Insert a randomly chosen set of full ids from town into goods info.
-        for (auto fId : Settings::aIFullIds(townProperty.fullIds())) goodsInfo.emplace(fId, false);
-    setNearby(town, town, Settings::getAITownRange());
+        for (auto fId : Settings::aIFullIds(townProperty.fullIds())) knowGood(fId, false);
+    setNearby(town);
     setLimits();
 }
 
-AI::AI(Traveler &tvl, const Save::AI *ldAI) : traveler(tvl), decisionCounter(ldAI->decisionCounter()) {
+AI::AI(Traveler &tvl, const Save::AI *ldAI)
+    : traveler(tvl), decisionCounter(ldAI->decisionCounter()), businessCounter(Settings::aIBusinessCounter()),
+      goodsInfo(std::make_shared<std::vector<GoodInfo>>()), role(static_cast<AIRole>(ldAI->role())) {
     // Load AI from flatbuffers.
     auto ldDecisionCriteria = ldAI->decisionCriteria();
-    std::transform(ldDecisionCriteria->begin(), ldDecisionCriteria->end(), begin(decisionCriteria),
+    EnumArray<double, DecisionCriteria> dcCrt;
+    std::transform(ldDecisionCriteria->begin(), ldDecisionCriteria->end(), begin(dcCrt),
                    [](double ldDecisionCriterion) { return ldDecisionCriterion; });
-    auto ldGoodsInfo = ldAI->goodsInfo();
-    std::transform(ldGoodsInfo->begin(), ldGoodsInfo->end(), std::inserter(goodsInfo, end(goodsInfo)),
-                   [](const Save::GoodInfo *ldGdInf) { return ldGdInf; });
+    // Share criteria with other AIs of the same archetype.
+    decisionCriteria = Settings::aIDecisionCriteria(ldAI->archetype(), dcCrt);
+    for (auto ldGdInf : *ldAI->goodsInfo()) {
+        knowGood(ldGdInf->fullId(), ldGdInf->owned());
+        ownGoodsInfo()[ldGdInf->fullId()] = GoodInfo(ldGdInf);
+    }
+    if (role >= AIRole::agent) traveler.setHome();
+    setNearby(traveler.town());
+    setLimits();
 }
 
 flatbuffers::Offset<Save::AI> AI::save(flatbuffers::FlatBufferBuilder &b) const {
-    auto svDecisionCriteria = b.CreateVector(std::vector<double>(begin(decisionCriteria), end(decisionCriteria)));
-    std::vector<GoodInfo> vGoodsInfo(begin(goodsInfo), end(goodsInfo));
-    auto svGoodsInfo = b.CreateVectorOfStructs<Save::GoodInfo>(
-        goodsInfo.size(), [vGoodsInfo](size_t i, Save::GoodInfo *gI) { *gI = vGoodsInfo[i].save(); });
-    return Save::CreateAI(b, static_cast<short>(decisionCounter), svDecisionCriteria, svGoodsInfo);
+    auto svDecisionCriteria = b.CreateVector(std::vector<double>(begin(*decisionCriteria), end(*decisionCriteria)));
+    std::vector<Save::GoodInfo> vGoodsInfo;
+    vGoodsInfo.reserve(known.count());
+    for (auto fId = known.find_first(); fId != known.npos; fId = known.find_next(fId))
+        vGoodsInfo.push_back(goodInfo(fId).save(owned[fId]));
+    auto svGoodsInfo = b.CreateVectorOfStructs(vGoodsInfo);
+    return Save::CreateAI(b, static_cast<short>(decisionCounter), svDecisionCriteria, svGoodsInfo,
+                          static_cast<unsigned int>(role), Settings::aIArchetype(decisionCriteria.get()));
+}
+
+std::vector<GoodInfo> &AI::ownGoodsInfo() {
+    // Copy goods info shared with another AI before changing it.
+    if (goodsInfo.use_count() > 1) goodsInfo = std::make_shared<std::vector<GoodInfo>>(*goodsInfo);
+    return *goodsInfo;
+}
+
+const GoodInfo &AI::knowGood(unsigned int fId, bool ond) {
+    // Add info for given good with given ownership if not already known. Return info for good.
+    if (fId >= known.size()) {
+        known.resize(fId + 1);
+        owned.resize(fId + 1);
+    }
+    if (!known[fId]) {
+        auto &gdsInf = ownGoodsInfo();
+        if (fId >= gdsInf.size()) gdsInf.resize(fId + 1);
+        gdsInf[fId] = GoodInfo(fId);
+        known.set(fId);
+        owned[fId] = ond;
+    }
+    return goodInfo(fId);
 }
 
-double AI::attackScore(const Good &eq, const EnumArray<unsigned int, Stat> &sts) const {
+double AI::attackScore(const Good &eq, const EnumArray<unsigned int, Stat> &sts) {
     // Scores given equipment with given stats based on its attack value.
     double score = 0;
     for (auto &cS : eq.getCombatStats()) {
@@ -81,14 +118,14 @@ double AI::attackScore(const Good &eq, const EnumArray<unsigned int, Stat> &sts)
     return score;
 }
 
-double AI::attackScore(const std::vector<Good> &eqpmt, const EnumArray<unsigned int, Stat> &sts) const {
+double AI::attackScore(const std::vector<Good> &eqpmt, const EnumArray<unsigned int, Stat> &sts) {
     // Scores given equipment with given stats based on its attack value.
     double score = 1;
     for (auto &eq : eqpmt) score += attackScore(eq, sts);
     return score;
 }
 
-double AI::defenseScore(const Good &eq, const EnumArray<unsigned int, Stat> &sts) const {
+double AI::defenseScore(const Good &eq, const EnumArray<unsigned int, Stat> &sts) {
     // Scores given equipment with given stats based on its defense value.
     double score = 0;
     for (auto &cS : eq.getCombatStats())
@@ -96,7 +133,7 @@ double AI::defenseScore(const Good &eq, const EnumArray<unsigned int, Stat> &sts
     return score;
 }
 
-double AI::defenseScore(const std::vector<Good> &eqpmt, const EnumArray<unsigned int, Stat> &sts) const {
+double AI::defenseScore(const std::vector<Good> &eqpmt, const EnumArray<unsigned int, Stat> &sts) {
     // Scores given equipment with given stats based on its defense value.
     double score = 1;
     for (auto &eq : eqpmt) score += defenseScore(eq, sts);
@@ -105,15 +142,15 @@ double AI::defenseScore(const std::vector<Good> &eqpmt, const EnumArray<unsigned
 
 double AI::equipScore(const Good &eq, const EnumArray<unsigned int, Stat> &sts) const {
     // Scores parameter equipment based on parameter stats and this ai's criteria. Score is always >= 0.
-    return attackScore(eq, sts) * decisionCriteria[DecisionCriteria::attackScoreWeight] +
-           defenseScore(eq, sts) * decisionCriteria[DecisionCriteria::defenseScoreWeight];
+    return attackScore(eq, sts) * (*decisionCriteria)[DecisionCriteria::attackScoreWeight] +
+           defenseScore(eq, sts) * (*decisionCriteria)[DecisionCriteria::defenseScoreWeight];
 }
 
-double AI::equipScore(const std::vector<Good> &eqpmt, const EnumArray<unsigned int, Stat> &sts) const {
-    // Scores parameter equipment with parameter stats based on this ai's criteria. Score is always >= 1.
-    double score = 1;
-    for (auto &eq : eqpmt) score += equipScore(eq, sts);
-    return score;
+double AI::equipScore(const Traveler &tvl) const {
+    // Scores given traveler's equipment with their stats based on this ai's criteria. Score is always >= 1.
+    auto &scores = tvl.getEquipmentScores();
+    return 1 + (scores.first - 1) * (*decisionCriteria)[DecisionCriteria::attackScoreWeight] +
+           (scores.second - 1) * (*decisionCriteria)[DecisionCriteria::defenseScoreWeight];
 }
 
 double AI::equipScore(const Good &eq, const std::vector<Good> &eqpmt, const EnumArray<unsigned int, Stat> &sts) const {
@@ -135,28 +172,50 @@ double AI::lootScore(const Property &tgtPpt) {
     double score = 0;
     tgtPpt.forGood([this, &score](const Good &tgtGd) {
         // Attempt to emplace the good to goods info.
-        auto gII = goodsInfo.emplace(tgtGd.getFullId(), false).first;
-        score += tgtGd.getAmount() * gII->getEstimate();
+        score += tgtGd.getAmount() * knowGood(tgtGd.getFullId(), false).getEstimate();
     });
     return score;
 }
 
 void AI::choosePlan(std::vector<BusinessPlan> &plns, BusinessPlan *&bstPln, double dcCt, double &hst) {
-    for (auto &pln : plns) {
-        // Reduce score by cost of build plan.
-        double score = pln.profit - pln.cost;
-        // Multiply score by decision criteria.
-        score *= dcCt;
-        if (score > hst) {
-            // Score for this build plan is better than current best score.
-            hst = score;
-            bstPln = &pln;
-        }
+    // Plans are ranked by profit less cost, so only the first can beat the current best.
+    if (plns.empty()) return;
+    auto &pln = plns.front();
+    // Reduce score by cost of build plan.
+    double score = pln.profit - pln.cost;
+    // Multiply score by decision criteria.
+    score *= dcCt;
+    if (score > hst) {
+        // Score for this build plan is better than current best score.
+        hst = score;
+        bstPln = &pln;
     }
 }
 
-void AI::trade() {
-    // Attempt to make best possible single trade in current town.
+void TownQuotes::quote(const Town *tn) {
+    // Load goods and prices of given town, unless already loaded and prices are unchanged.
+    auto &ppt = tn->getProperty();
+    if (tn == town && ppt.getPriceEpoch() == epoch) return;
+    town = tn;
+    epoch = ppt.getPriceEpoch();
+    goods.clear();
+    prices.clear();
+    carries.clear();
+    ppt.forGood([this](const Good &gd) {
+        auto fId = gd.getFullId();
+        if (fId >= goods.size()) {
+            goods.resize(fId + 1, nullptr);
+            prices.resize(fId + 1);
+            carries.resize(fId + 1);
+        }
+        goods[fId] = &gd;
+        prices[fId] = gd.price();
+        carries[fId] = gd.getCarry();
+    });
+}
+
+template <AIRole R> void AI::trade(const TownQuotes &qts) {
+    // Attempt to make best possible single trade in current town using given quotes of its goods.
     double criteriaMax = Settings::getAIDecisionCriteriaMax();
     auto town = traveler.town();
     auto townId = town->getId();
@@ -166,7 +225,7 @@ void AI::trade() {
         storageProperty->forGood([this](const Good &gd) {
             Good wG(gd);
             traveler.withdraw(wG);
-            goodsInfo.emplace(gd.getFullId(), true);
+            knowGood(gd.getFullId(), true);
         });
     // Clear offer and request from previous trade.
     traveler.clearTrade();
@@ -175,23 +234,20 @@ void AI::trade() {
     std::unique_ptr<Good> bestGood;
     // Find highest sell score.
     auto &travelerProperty = traveler.property();
-    auto &byOwned = goodsInfo.get<Owned>();
-    auto rng = byOwned.equal_range(true);
-    decltype(rng.first) sellInfo; // info for good sold
-    for (; rng.first != rng.second; ++rng.first) {
-        auto &gd = *travelerProperty.good(rng.first->getFullId());
+    size_t sellId = 0; // full id of good sold
+    for (auto fId = owned.find_first(); fId != owned.npos; fId = owned.find_next(fId)) {
+        auto &gd = *travelerProperty.good(static_cast<unsigned int>(fId));
         double gWgt = gd.weight();
         if (!overWeight || gWgt > 0) {
             // Either we are not over weight or given material doesn't help carry.
-            auto fId = gd.getFullId();
-            auto tnGd = traveler.town()->getProperty().good(fId);
+            auto tnGd = qts.good(fId);
             if (tnGd == nullptr) return;
             auto amount = gd.getAmount();
             if (amount > 0) {
                 if (gWgt < 0 && weight > gWgt)
                     // This good is needed to carry existing goods, reduce amount.
                     amount *= weight / gWgt;
-                double score = rng.first->sellScore(tnGd->price()); // score based on minimum sell price
+                double score = goodInfo(fId).sellScore(qts.prices[fId]); // score based on minimum sell price
                 if ((overWeight && (!bestGood || gWgt > bestGood->weight())) || (score > highest)) {
                     // Either we are over weight and good is heavier than previous offer or this good scores better.
                     highest = score;
@@ -199,7 +255,7 @@ void AI::trade() {
                     offerValue = tnGd->price(amount);
                     offerWeight = gWgt;
                     bestGood = std::make_unique<Good>(tnGd->getFullId(), tnGd->getFullName(), amount, tnGd->getMeasure());
-                    sellInfo = rng.first;
+                    sellId = fId;
                 }
             }
         }
@@ -220,12 +276,13 @@ void AI::trade() {
     std::vector<BusinessPlan> buildPlans, // plans to build businesses in current town
         restockPlans;                     // plans to restock businesses in current town
     BusinessPlan *bestPlan = nullptr;     // pointer to highest scoring business plan
-    if (role == AIRole::trader) {
+    if constexpr (R == AIRole::trader) {
         auto home = traveler.getHome();
         if (++businessCounter >= 0 && (!home || town == home)) {
             // Find best business scored based on requirements, inputs, and outputs.
             buildPlans = townProperty.buildPlans(travelerProperty, offerValue);
-            choosePlan(buildPlans, bestPlan, decisionCriteria[DecisionCriteria::buildTendency] / criteriaMax, highest);
+            choosePlan(buildPlans, bestPlan, (*decisionCriteria)[DecisionCriteria::buildTendency] / criteriaMax,
+                       highest);
             if (bestPlan && bestPlan->cost == 0) {
                 // Build business without trading.
                 traveler.build(bestPlan->business, bestPlan->factor);
@@ -236,7 +293,7 @@ void AI::trade() {
             if (storageProperty) {
                 restockPlans = townProperty.restockPlans(travelerProperty, *storageProperty, offerValue);
                 choosePlan(restockPlans, bestPlan,
-                           decisionCriteria[DecisionCriteria::restockTendency] / criteriaMax, highest);
+                           (*decisionCriteria)[DecisionCriteria::restockTendency] / criteriaMax, highest);
             }
             businessCounter = -Settings::getAIBusinessInterval();
         }
@@ -249,19 +306,19 @@ void AI::trade() {
     // Find highest buy score among goods not owned.
     auto &equipment = traveler.getEquipment();
     auto &stats = traveler.getStats();
-    rng = byOwned.equal_range(false);
-    decltype(rng.first) buyInfo; // info for good bought
-    for (; rng.first != rng.second; ++rng.first) {
-        auto fId = rng.first->getFullId();
-        auto tnGd = townProperty.good(fId);
+    auto unowned = known - owned;
+    // Weigh equip score double if not a trader or agent.
+    constexpr double equipWeight = 1 + !(R == AIRole::trader || R == AIRole::agent);
+    size_t buyId = 0; // full id of good bought
+    for (auto uId = unowned.find_first(); uId != unowned.npos; uId = unowned.find_next(uId)) {
+        auto fId = static_cast<unsigned int>(uId);
+        auto tnGd = qts.good(fId);
         if (!tnGd) return;
-        double carry = tnGd->getCarry();
+        double carry = qts.carries[fId];
         if (!overWeight || carry < 0) {
-            double score = rng.first->buyScore(tnGd->price()); // score based on maximum buy price
-            // Weigh equip score double if not a trader or agent.
-            double eqpScr = equipScore(*tnGd, equipment, stats) *
-                            (1 + !(role == AIRole::trader || role == AIRole::agent)) *
-                            decisionCriteria[DecisionCriteria::equipScoreWeight] / criteriaMax;
+            double score = goodInfo(fId).buyScore(qts.prices[fId]); // score based on maximum buy price
+            double eqpScr = equipScore(*tnGd, equipment, stats) * equipWeight *
+                            (*decisionCriteria)[DecisionCriteria::equipScoreWeight] / criteriaMax;
             score += eqpScr;
             if (score > highest) {
                 highest = score;
@@ -283,26 +340,25 @@ void AI::trade() {
                     // Convert the excess from units of bought good to deniers.
                     excess = tnGd->price(excess);
                     bestGood = std::make_unique<Good>(fId, tnGd->getFullName(), amount, tnGd->getMeasure());
-                    buyInfo = rng.first;
+                    buyId = fId;
                 }
             }
         }
     }
-    auto setOwned = [](bool ond) { return [ond](GoodInfo &gdInf) { gdInf.setOwned(ond); }; };
     if (bestGood) {
         // Purchasing a good exceeded score of building a business.
         if (excess > 0) traveler.divideExcess(excess, townProfit);
         traveler.requestGood(std::move(*bestGood));
-        traveler.makeTrade();
-        byOwned.modify(sellInfo, setOwned(false));
-        byOwned.modify(buyInfo, setOwned(true));
+        traveler.placeOrder();
+        owned.reset(sellId);
+        owned.set(buyId);
     } else if (bestPlan) {
         // No good exceeded score of building business.
         excess = offerValue - bestPlan->cost;
         if (excess > 0) traveler.divideExcess(excess, townProfit);
         traveler.requestGoods(std::move(bestPlan->request));
         traveler.makeTrade();
-        byOwned.modify(sellInfo, setOwned(false));
+        owned.reset(sellId);
         if (bestPlan->build) {
             traveler.setHome();
             traveler.build(bestPlan->business, bestPlan->factor);
@@ -341,41 +397,22 @@ void AI::equip() {
     });
 }
 
-void AI::attack() {
-    // Attack traveler with lower equipment score and lootable goods.
-    switch (role) {
-    case AIRole::bandit:
-        if (!traveler.getTarget()) {
-            // There isn't already a target.
-            auto able = traveler.attackable();
-            double ourEquipScore = equipScore(traveler.getEquipment(), traveler.getStats());
-            // Remove travelers who do not meet threshold for attacking.
-            able.erase(std::remove_if(begin(able), end(able),
-                                      [this, ourEquipScore](const Traveler *a) {
-                                          return lootScore(a->property()) * ourEquipScore *
-                                                     decisionCriteria[DecisionCriteria::fightTendency] /
-                                                     equipScore(a->getEquipment(), a->getStats()) <
-                                                 Settings::getAIAttackThreshold();
-                                      }),
-                       end(able));
-            if (!able.empty()) {
-                // Attack the easiest target.
-                Traveler *easiest = nullptr;
-                double lowest = std::numeric_limits<double>::max();
-                for (auto tvl : able) {
-                    double score = equipScore(tvl->getEquipment(), tvl->getStats());
-                    if (score < lowest) {
-                        lowest = score;
-                        easiest = tvl;
-                    }
-                }
-                traveler.attack(easiest);
-            }
-        }
-        break;
-    default:
-        break;
-    }
+void AI::ambush(std::vector<Traveler *> tgts) {
+    // Attack the traveler with lowest equipment score among given travelers which came within attack distance whose
+    // goods are worth the fight. Travelers passed over while fighting are picked up again when the fight ends.
+    if (role != AIRole::bandit || !traveler.getEnemies().empty()) return;
+    // Drop encounters which no longer hold.
+    auto able = traveler.attackable();
+    std::erase_if(tgts, [&able](Traveler *tgt) { return std::find(begin(able), end(able), tgt) == end(able); });
+    std::vector<std::pair<double, Traveler *>> scores; // equipment scores of targets
+    scores.reserve(tgts.size());
+    for (auto tgt : tgts) scores.emplace_back(equipScore(*tgt), tgt);
+    std::stable_sort(begin(scores), end(scores),
+                     [](const auto &a, const auto &b) { return a.first < b.first; });
+    double ownScore = equipScore(traveler) * (*decisionCriteria)[DecisionCriteria::fightTendency];
+    for (auto scIt = begin(scores); scIt != end(scores); ++scIt)
+        if (lootScore(scIt->second->property()) * ownScore / scIt->first >= Settings::getAIAttackThreshold())
+            return traveler.attack(scIt->second);
 }
 
 FightChoice AI::choice() {
@@ -383,20 +420,20 @@ FightChoice AI::choice() {
     EnumArray<double, FightChoice> scores; // fight, run, yield scores
     double allyEquipScore = 0, enemyEquipScore = 0, fastest = 0;
     traveler.forAlly([this, &allyEquipScore](Traveler *aly) {
-        allyEquipScore += equipScore(aly->getEquipment(), aly->getStats());
+        allyEquipScore += equipScore(*aly);
     });
     for (auto enemy : traveler.getEnemies()) {
         double enemySpeed = std::numeric_limits<double>::max();
         enemy->forAlly([this, &enemyEquipScore, &enemySpeed](Traveler *aly) {
-            enemyEquipScore += equipScore(aly->getEquipment(), aly->getStats());
+            enemyEquipScore += equipScore(*aly);
             enemySpeed = std::min(aly->speed(), enemySpeed);
         });
         fastest = std::max(enemySpeed, fastest);
     }
     double equipmentScoreRatio = allyEquipScore / enemyEquipScore;
-    scores[FightChoice::fight] = 1 / equipmentScoreRatio * decisionCriteria[DecisionCriteria::fightTendency];
-    scores[FightChoice::run] = equipmentScoreRatio * decisionCriteria[DecisionCriteria::runTendency];
-    scores[FightChoice::yield] = equipmentScoreRatio * decisionCriteria[DecisionCriteria::yieldTendency];
+    scores[FightChoice::fight] = 1 / equipmentScoreRatio * (*decisionCriteria)[DecisionCriteria::fightTendency];
+    scores[FightChoice::run] = equipmentScoreRatio * (*decisionCriteria)[DecisionCriteria::runTendency];
+    scores[FightChoice::yield] = equipmentScoreRatio * (*decisionCriteria)[DecisionCriteria::yieldTendency];
     if (equipmentScoreRatio > 1)
         // Target's equipment is better, weigh run score by speed ratio.
         scores[FightChoice::run] *= traveler.speed() / fastest;
@@ -410,10 +447,9 @@ Traveler *AI::target(const std::unordered_set<Traveler *> &enms) const {
     for (auto enm : enms) {
         enm->forAlly([this, &tgt, &highest](Traveler *aly) {
             if (!aly->alive()) return;
-            auto &eqpmt = aly->getEquipment();
-            auto &sts = aly->getStats();
+            auto &scores = aly->getEquipmentScores();
             unsigned int tgtrCnt = aly->getTargeterCount();
-            double score = attackScore(eqpmt, sts) / defenseScore(eqpmt, sts) / tgtrCnt;
+            double score = scores.first / scores.second / tgtrCnt;
             if (score > highest) {
                 highest = score;
                 tgt = aly;
@@ -445,171 +481,250 @@ void AI::loot() {
         return a + lootScore(enm->property());
     });
     auto target = lootTarget(enemies);
-    auto targetProperty = &target->property();
+    if (!target) return;
     if (target->alive())
         // Looting from an alive target dependent on greed.
-        lootGoal *= decisionCriteria[DecisionCriteria::lootingGreed] / Settings::getAIDecisionCriteriaMax();
+        lootGoal *= (*decisionCriteria)[DecisionCriteria::lootingGreed] / Settings::getAIDecisionCriteriaMax();
     double looted = 0, weight = traveler.weight();
-    while (looted < lootGoal) {
-        // Keep looting until amount looted matches goal or we can carry no more.
-        double highest = 0, bestValue, bestWeight;
-        std::unique_ptr<Good> bestGood;
-        GoodInfoContainer::iterator bestGoodInfo;
-        targetProperty->forGood([this, &highest, &bestValue, &bestWeight, &bestGood, &bestGoodInfo, looted,
-                                 lootGoal](const Good &tgtGd) {
+    std::vector<LootChoice> choices;
+    while (target && looted < lootGoal) {
+        // Score target's goods once by value per weight.
+        choices.clear();
+        target->property().forGood([this, &choices](const Good &tgtGd) {
             double amount = tgtGd.getAmount();
-            if (amount > 0) {
-                // Attempt to emplace good to goods info.
-                auto gII = goodsInfo.emplace(tgtGd.getFullId(), false).first; // iterator to good in goods info
-                double estimate = gII->getEstimate();
-                double carry = tgtGd.getCarry();
-                double score;
-                if (carry > 0)
-                    // Heavier goods score lower.
-                    score = estimate / carry;
-                else if (carry == 0)
-                    // Weightless goods score highest.
-                    score = std::numeric_limits<double>::max();
-                else
-                    // Goods that carry other good score negative.
-                    score = carry;
-                if ((highest >= 0 && score > highest) || (score < 0 && score < highest)) {
-                    // Either this is more valuable per weight than current best or this helps carry more than current best.
-                    highest = score;
-                    amount = std::min((lootGoal - looted) / estimate, amount);
-                    bestValue = estimate * amount;
-                    bestWeight = carry * amount;
-                    bestGood = std::make_unique<Good>(tgtGd.getFullId(), amount);
-                    bestGoodInfo = gII;
-                }
-            }
+            if (amount <= 0) return;
+            // Attempt to add good to goods info.
+            double estimate = knowGood(tgtGd.getFullId(), false).getEstimate();
+            double carry = tgtGd.getCarry();
+            double score;
+            if (carry > 0)
+                // Heavier goods score lower.
+                score = estimate / carry;
+            else if (carry == 0)
+                // Weightless goods score highest.
+                score = std::numeric_limits<double>::max();
+            else
+                // Goods that carry other good score negative.
+                score = carry;
+            if (score != 0) choices.push_back({tgtGd.getFullId(), score, estimate, carry, amount});
         });
-        if (!bestGood) {
-            // Target has no more goods to loot.
-            enemies.erase(target);
-            target = lootTarget(enemies);
-            targetProperty = &target->property();
-            continue;
+        // Take goods that help carry most first, then goods most valuable per weight.
+        std::sort(begin(choices), end(choices), [](const LootChoice &a, const LootChoice &b) {
+            if ((a.score < 0) != (b.score < 0)) return a.score < 0;
+            return a.score < 0 ? a.score < b.score : a.score > b.score;
+        });
+        for (auto &ch : choices) {
+            // Keep looting until amount looted matches goal or we can carry no more.
+            if (looted >= lootGoal) return;
+            double amount = std::min((lootGoal - looted) / ch.estimate, ch.amount);
+            // Stop looting if we would be overweight.
+            weight += ch.carry * amount;
+            if (weight > 0) return;
+            owned.set(ch.fullId);
+            Good lootGood(ch.fullId, amount);
+            traveler.loot(lootGood);
+            looted += ch.estimate * amount;
         }
-        // Add the weight of looted good to weight variable.
-        weight += bestWeight;
-        // Stop looting if we would be overweight.
-        if (weight > 0) return;
-        // Loot the current best good from target.
-        traveler.loot(*bestGood);
-        goodsInfo.modify(bestGoodInfo, [](GoodInfo &gdInf) { gdInf.setOwned(true); });
-        looted += bestValue;
+        // Target has no more goods to loot, move on to next enemy.
+        if (!enemies.erase(target)) return;
+        target = lootTarget(enemies);
     }
 }
 
-void AI::setNearby(const Town *t, const Town *tT, unsigned int i) {
-    // Recursively adds towns i steps away to nearby towns. Clears buy and sell scores.
-    if (t == tT)
-        // Town t is the current town, clear nearby towns.
-        nearby.clear();
-    if (i)
-        // Town t is within i steps of town tT.
-        for (auto &nb : t->getNeighbors())
-            if (nb != tT && std::find_if(begin(nearby), end(nearby), [nb](TownInfo t) { return t.town == nb; }) ==
-                                end(nearby)) {
-                // Neighbor n is not the current town and not already in nearby towns.
-                nearby.push_back({nb, 0, 0});
-                setNearby(nb, tT, i - 1);
-            }
+void AI::setNearby(const Town *t) {
+    // Sets nearby towns to given town's region. Clears buy and sell scores.
+    nearby = t->getRegion();
+    nearbyInfo.assign(nearby.size(), {0, 0});
 }
 
-void AI::setLimits() {
-    // Sets buy and sell limits and min/max prices to reflect current nearby towns. Also updates buy and sell scores.
-    for (auto &nb : nearby) {
-        // Reset buy/sell scores
-        nb.buyScore = 0;
-        nb.sellScore = 0;
-        // Find minimum and maximum price for each good in nearby towns.
-        auto &townProperty = nb.town->getProperty();
-        for (auto gdInfIt = begin(goodsInfo); gdInfIt != end(goodsInfo); ++gdInfIt) {
-            auto nbGd = townProperty.good(gdInfIt->getFullId());
-            if (!nbGd) continue;
-            auto price = nbGd->price();
-            goodsInfo.modify(gdInfIt, [price](GoodInfo &gdInf) { gdInf.setMinMax(price); });
+const Town *AI::distantTown() const {
+    // Find buy town of best trade route across all towns for goods not owned, per weight and distance to travel.
+    auto &gameData = traveler.getGameData();
+    auto arbitrage = gameData.arbitrage;
+    if (!arbitrage) return nullptr;
+    const Town *town = traveler.town(), *bestTown = nullptr;
+    double highest = 0;
+    // Distances are in degrees, keep the one pixel offset scores had when distances were in pixels.
+    double pixel = 1 / Settings::getScale();
+    auto unowned = known - owned;
+    for (auto fId = unowned.find_first(); fId != unowned.npos; fId = unowned.find_next(fId)) {
+        auto route = arbitrage->route(static_cast<unsigned int>(fId));
+        if (!route || !route->buyTown || route->buyTown == route->sellTown) continue;
+        double score = route->marginPerWeight / (pixel + gameData.routeTable->distance(town, route->buyTown) +
+                                                 route->distance);
+        if (score > highest) {
+            highest = score;
+            bestTown = route->buyTown;
         }
     }
-    // Set value and buy and sell based on min and max prices.
+    return bestTown;
+}
+
+void AI::setLimits() {
+    // Sets buy and sell limits and min/max prices to reflect current nearby towns. Also updates buy and sell scores.
+    // Reset buy/sell scores
+    nearbyInfo.assign(nearby.size(), {0, 0});
+    // Find minimum and maximum price for each known good in nearby towns from regional price index of current town,
+    // then set value and buy and sell based on min and max prices.
+    auto &regionalPrices = traveler.town()->getRegionalPrices();
     double townProfit = Settings::getTownProfit();
-    for (auto gdInfIt = begin(goodsInfo); gdInfIt != end(goodsInfo); ++gdInfIt) {
-        goodsInfo.modify(gdInfIt, [townProfit](GoodInfo &gdInf) { gdInf.appraise(townProfit); });
+    for (auto fId = known.find_first(); fId != known.npos; fId = known.find_next(fId)) {
+        GoodInfo gdInf = goodInfo(fId);
+        auto rgPrcIt = regionalPrices.find(static_cast<unsigned int>(fId));
+        if (rgPrcIt != end(regionalPrices)) {
+            gdInf.setMinMax(rgPrcIt->second.min);
+            gdInf.setMinMax(rgPrcIt->second.max);
+        }
+        gdInf.appraise(townProfit);
+        // Only write changed info so that info shared with another AI is copied only when it diverges.
+        if (!(gdInf == goodInfo(fId))) ownGoodsInfo()[fId] = gdInf;
     }
-    // Loop through nearby towns again now that info has been gathered to set buy and sell scores.
-    for (auto &nb : nearby) {
-        auto &townProperty = nb.town->getProperty();
-        auto &byOwned = goodsInfo.get<Owned>();
-        // Set sell scores for goods owned.
-        auto rng = byOwned.equal_range(true);
-        std::for_each(rng.first, rng.second, [&nb, &townProperty](const GoodInfo &gdInf) {
-            auto nbGd = townProperty.good(gdInf.getFullId());
-            if (!nbGd) return;
-            nb.sellScore = std::max(gdInf.sellScore(nbGd->price()), nb.sellScore);
-        });
-        // Set buy scores for goods not owned.
-        rng = byOwned.equal_range(false);
-        std::for_each(rng.first, rng.second, [&nb, &townProperty](const GoodInfo &gdInf) {
-            auto nbGd = townProperty.good(gdInf.getFullId());
-            if (!nbGd) return;
-            nb.buyScore = std::max(gdInf.buyScore(nbGd->price()), nb.buyScore);
-        });
+    // Loop through nearby towns now that info has been gathered to set buy and sell scores.
+    for (size_t i = 0; i < nearby.size(); ++i) {
+        auto &nb = nearbyInfo[i];
+        auto &townProperty = nearby[i]->getProperty();
+        for (auto fId = known.find_first(); fId != known.npos; fId = known.find_next(fId)) {
+            auto nbGd = townProperty.good(static_cast<unsigned int>(fId));
+            if (!nbGd) continue;
+            if (owned[fId])
+                // Set sell score for good owned.
+                nb.sellScore = std::max(goodInfo(fId).sellScore(nbGd->price()), nb.sellScore);
+            else
+                // Set buy score for good not owned.
+                nb.buyScore = std::max(goodInfo(fId).buyScore(nbGd->price()), nb.buyScore);
+        }
     }
 }
 
+void AI::refreshNearby() {
+    // Set nearby towns again from current town's region, which may have been found again.
+    setNearby(traveler.town());
+    setLimits();
+}
+
 void AI::pickTown(const Town *tn) {
     // Make traveler move toward town and refresh nearby town data.
     traveler.pickTown(tn);
     // Set nearby towns based on town traveler travels to first.
     const Town *town = traveler.town();
-    setNearby(town, town, Settings::getAITownRange());
+    setNearby(town);
     setLimits();
 }
 
+void AI::makePlan(const Town *tn, bool rstk) {
+    // Plan to sell the owned good which scores highest in given town, then return home if restocking.
+    plan = {};
+    auto &townProperty = tn->getProperty();
+    double highest = 0;
+    for (auto fId = owned.find_first(); fId != owned.npos; fId = owned.find_next(fId)) {
+        auto tnGd = townProperty.good(static_cast<unsigned int>(fId));
+        if (!tnGd) continue;
+        double price = tnGd->price();
+        double score = goodInfo(fId).sellScore(price);
+        if (score > highest) {
+            highest = score;
+            plan.sellTown = tn;
+            plan.goodId = static_cast<unsigned int>(fId);
+            plan.sellPrice = price;
+        }
+    }
+    auto home = traveler.getHome();
+    if (plan.sellTown && rstk && home && home != tn) plan.restockTown = home;
+}
+
+bool AI::planHolds() const {
+    // Check that traveler is not fighting or overloaded and, until it sells, still carries planned good and its
+    // price in sell town has not moved past tolerance.
+    if (traveler.getTarget() || traveler.getTargeterCount() || traveler.weight() > 0) return false;
+    if (!plan.sellTown) return true;
+    auto gd = traveler.property().good(plan.goodId);
+    if (!owned[plan.goodId] || !gd || gd->getAmount() <= 0) return false;
+    auto tnGd = plan.sellTown->getProperty().good(plan.goodId);
+    return tnGd && std::abs(tnGd->price() - plan.sellPrice) <= plan.sellPrice * Settings::getAIPlanTolerance();
+}
+
 void AI::update(unsigned int elTm) {
-    // Run the AI for the elapsed time. Includes trading, equipping, and attacking.
-    if (!traveler.getMoving()) {
-        decisionCounter += elTm;
-        if (decisionCounter > 0) {
-            decisionCounter -= Settings::getAIDecisionTime();
-            auto town = traveler.town(), home = traveler.getHome();
-            if (role >= AIRole::agent) {
-                // AI role is employee.
-                auto contract = traveler.getContract();
-                if (!contract)
-                    // AI has not placed bid yet.
-                    if (traveler.town() == home)
-                        return traveler.bid(decisionCriteria[DecisionCriteria::bonusGreed],
-                                            traveler.town()->getProperty().good(0)->price() *
-                                                decisionCriteria[DecisionCriteria::wageGreed]);
-                    else
-                        return pickTown(home);
-                else if (contract->party == &traveler)
-                    return;
-            }
-            trade();
-            equip();
-            attack();
-            // Find highest score based on buy and sell scores in each town.
-            const Town *bestTown = nullptr;
-            if (businessCounter >= 0 && home)
-                // Return to home.
+    // Count down to next decision while traveler is stopped.
+    if (!traveler.getMoving()) decisionCounter += elTm;
+}
+
+bool AI::decisionDue() const { return decisionCounter > 0 && !traveler.getMoving(); }
+
+const EnumArray<AI::Kernel, AIRole> AI::kernels{{&AI::decide<AIRole::trader>, &AI::decide<AIRole::soldier>,
+                                                  &AI::decide<AIRole::bandit>, &AI::decide<AIRole::agent>,
+                                                  &AI::decide<AIRole::guard>, &AI::decide<AIRole::thug>}};
+
+void AI::decide(TownQuotes &qts) {
+    // Run decision kernel for this AI's role.
+    (this->*kernels[role])(qts);
+}
+
+template <AIRole R> void AI::decide(TownQuotes &qts) {
+    // Make a decision for an AI with role R. Includes trading, equipping, and picking a town. Follows current plan
+    // without searching while it holds. Town quotes are shared with other AIs deciding in the same town.
+    decisionCounter -= Settings::getAIDecisionTime();
+    auto town = traveler.town(), home = traveler.getHome();
+    if constexpr (R >= AIRole::agent) {
+        // AI role is employee.
+        auto contract = traveler.getContract();
+        if (!contract)
+            // AI has not placed bid yet.
+            if (traveler.town() == home)
+                return traveler.bid((*decisionCriteria)[DecisionCriteria::bonusGreed],
+                                    traveler.town()->getProperty().good(0)->price() *
+                                        (*decisionCriteria)[DecisionCriteria::wageGreed]);
+            else
                 return pickTown(home);
-            // Find highest scoring town.
-            double highest = 0;
-            for (auto &tI : nearby) {
-                double score = tI.buyScore * decisionCriteria[DecisionCriteria::buyScoreWeight] +
-                               tI.sellScore * decisionCriteria[DecisionCriteria::sellScoreWeight];
-                if (score > highest) {
-                    highest = score;
-                    bestTown = tI.town;
-                }
-            }
-            if (bestTown && bestTown != town)
-                // A town was found.
-                pickTown(bestTown);
+        else if (contract->party == &traveler)
+            return;
+    }
+    bool traded = false;
+    if (auto next = plan.next()) {
+        if (planHolds()) {
+            if (next != town)
+                // Continue toward next town of plan.
+                return traveler.pickTown(next);
+            // Trade in town reached by plan, then continue toward following town if any.
+            plan.advance();
+            qts.quote(town);
+            trade<R>(qts);
+            equip();
+            traded = true;
+            next = plan.next();
+            if (next) return traveler.pickTown(next);
+        } else
+            plan = {};
+        // Nearby towns were last set when plan was made, refresh them before searching.
+        setNearby(town);
+        setLimits();
+    }
+    if (!traded) {
+        qts.quote(town);
+        trade<R>(qts);
+        equip();
+    }
+    // Find highest score based on buy and sell scores in each town.
+    const Town *bestTown = nullptr;
+    if (businessCounter >= 0 && home)
+        // Return to home.
+        return pickTown(home);
+    // Find highest scoring town.
+    double highest = 0;
+    for (size_t i = 0; i < nearby.size(); ++i) {
+        auto &tI = nearbyInfo[i];
+        double score = tI.buyScore * (*decisionCriteria)[DecisionCriteria::buyScoreWeight] +
+                       tI.sellScore * (*decisionCriteria)[DecisionCriteria::sellScoreWeight];
+        if (score > highest) {
+            highest = score;
+            bestTown = nearby[i];
         }
     }
+    if (!bestTown)
+        // No nearby town scores, look further afield.
+        bestTown = distantTown();
+    if (bestTown && bestTown != town) {
+        // A town was found.
+        makePlan(bestTown, R == AIRole::trader);
+        pickTown(bestTown);
+    }
 }
@@ -22,16 +22,14 @@
 
 #include <functional>
 #include <memory>
+#include <span>
+#include <vector>
 
-#include <boost/multi_index/hashed_index.hpp>
-#include <boost/multi_index/mem_fun.hpp>
-#include <boost/multi_index/member.hpp>
-#include <boost/multi_index_container.hpp>
-
-namespace mi = boost::multi_index;
+#include <boost/dynamic_bitset.hpp>
 
 #include "save_generated.h"
 
+#include "arbitrage.hpp"
 #include "property.hpp"
 #include "traveler.hpp"
 
@@ -44,23 +42,22 @@ class Town;
 class Traveler;
 
 class GoodInfo {
-    unsigned int fullId;
-    bool owned;
-    double limitFactor,      // factor controlling value based on min/max price
-        min, max,            // minimum and maximum price of material seen
-        estimate, buy, sell; // estimated value, maximum buy price, and minimum sell price
+    unsigned int fullId = 0;
+    double limitFactor = 0,              // factor controlling value based on min/max price
+        min = 0, max = 0,                // minimum and maximum price of material seen
+        estimate = 0, buy = 0, sell = 0; // estimated value, maximum buy price, and minimum sell price
 public:
-    GoodInfo(unsigned int fId, bool ond);
+    GoodInfo() = default;
+    GoodInfo(unsigned int fId);
     GoodInfo(const Save::GoodInfo *ldGdInf);
-    Save::GoodInfo save() const;
+    Save::GoodInfo save(bool ond) const;
     unsigned int getFullId() const { return fullId; }
-    bool getOwned() const { return owned; }
     double getEstimate() const { return estimate; }
     double getBuy() const { return buy; }
+    bool operator==(const GoodInfo &other) const = default;
     double getSell() const { return sell; }
     double buyScore(double prc) const { return prc == 0 ? 0 : buy / prc; }    // score selling at price p
     double sellScore(double prc) const { return sell == 0 ? 0 : prc / sell; } // score buying at price p
-    void setOwned(bool ond) { owned = ond; }
     void setMinMax(double m) {
         min = std::min(m, min);
         max = std::max(m, max);
@@ -69,10 +66,33 @@ public:
 };
 
 struct TownInfo {
-    Town *town;                 // pointer to town in question
     double buyScore, sellScore; // highest buy and sell scores for town
 };
 
+struct LootChoice {
+    unsigned int fullId;
+    double score, estimate, carry, amount; // value per weight, estimated value, carry, and amount of target's good
+};
+
+struct TradePlan {
+    const Town *sellTown = nullptr, // town to sell planned good in
+        *restockTown = nullptr;     // town to return to for restocking businesses after selling
+    unsigned int goodId = 0;        // full id of good carried to sell town
+    double sellPrice = 0;           // price of good in sell town when plan was made
+    const Town *next() const { return sellTown ? sellTown : restockTown; }
+    void advance() { (sellTown ? sellTown : restockTown) = nullptr; }
+};
+
+struct TownQuotes {
+    const Town *town = nullptr;      // town whose goods are quoted
+    unsigned int epoch = 0;          // price epoch of town's property when quoted
+    std::vector<const Good *> goods; // town's goods, indexed by full id
+    std::vector<double> prices;      // price of one unit of each good, indexed by full id
+    std::vector<double> carries;     // carry of each good, indexed by full id
+    void quote(const Town *tn);
+    const Good *good(size_t fId) const { return fId < goods.size() ? goods[fId] : nullptr; }
+};
+
 /**
  * AI which runs non-player travelers
  */
@@ -80,45 +100,60 @@ class AI {
     Traveler &traveler;                                   // the traveler this AI controls
     int decisionCounter,                                  // counter for updating AI
         businessCounter;                                  // counter for making business decisions
-    EnumArray<double, DecisionCriteria> decisionCriteria; /* buy/sell score
-    weight, weapon/armor equip score, tendency to fight/run/yield, looting greed */
-    using FlId = mi::const_mem_fun<GoodInfo, unsigned int, &GoodInfo::getFullId>;
-    using Ownd = mi::const_mem_fun<GoodInfo, bool, &GoodInfo::getOwned>;
-    using FlIdHsh = mi::hashed_unique<mi::tag<struct FullId>, FlId>;
-    using OwndHsh = mi::hashed_non_unique<mi::tag<struct Owned>, Ownd>;
-    using GoodInfoContainer = boost::multi_index_container<GoodInfo, mi::indexed_by<FlIdHsh, OwndHsh>>;
-    GoodInfoContainer goodsInfo;  // known information about each good by full id
-    std::vector<TownInfo> nearby; // known information about nearby towns
-    AIRole role;                  // behavior for this ai
-    void setNearby(const Town *t, const Town *tT, unsigned int i);
+    std::shared_ptr<const EnumArray<double, DecisionCriteria>> decisionCriteria; /* buy/sell score weight,
+    weapon/armor equip score, tendency to fight/run/yield, looting greed; shared by AIs of the same archetype */
+    std::shared_ptr<std::vector<GoodInfo>> goodsInfo; // known information about each good by full id, copied on write
+    boost::dynamic_bitset<> known, owned;             // whether each good is known and owned, by full id
+    std::span<Town *const> nearby;    // towns within AI town range of current town
+    std::vector<TownInfo> nearbyInfo; // known information about nearby towns
+    AIRole role;                      // behavior for this ai
+    TradePlan plan;                   // towns to travel to without searching while plan holds
+    const GoodInfo &goodInfo(size_t fId) const { return (*goodsInfo)[fId]; }
+    std::vector<GoodInfo> &ownGoodsInfo();
+    const GoodInfo &knowGood(unsigned int fId, bool ond);
+    void setNearby(const Town *t);
+    const Town *distantTown() const;
     void setLimits();
-    double attackScore(const Good &eq, const EnumArray<unsigned int, Stat> &sts) const;
-    double attackScore(const std::vector<Good> &eqpmt, const EnumArray<unsigned int, Stat> &sts) const;
-    double defenseScore(const Good &eq, const EnumArray<unsigned int, Stat> &sts) const;
-    double defenseScore(const std::vector<Good> &eqpmt, const EnumArray<unsigned int, Stat> &sts) const;
+    static double attackScore(const Good &eq, const EnumArray<unsigned int, Stat> &sts);
+    static double defenseScore(const Good &eq, const EnumArray<unsigned int, Stat> &sts);
     double equipScore(const Good &eq, const EnumArray<unsigned int, Stat> &sts) const;
-    double equipScore(const std::vector<Good> &eqpmt, const EnumArray<unsigned int, Stat> &sts) const;
+    double equipScore(const Traveler &tvl) const;
     double equipScore(const Good &eq, const std::vector<Good> &eqpmt, const EnumArray<unsigned int, Stat> &sts) const;
     double lootScore(const Property &ppt);
     void choosePlan(std::vector<BusinessPlan> &plns, BusinessPlan *&bstPln, double dcCt, double &hst);
-    void trade();
+    template <AIRole R> void trade(const TownQuotes &qts);
     void store(const Property *sPpt, const Property &tPpt);
     void equip();
-    void attack();
     void pickTown(const Town *tn);
+    void makePlan(const Town *tn, bool rstk);
+    bool planHolds() const;
+    template <AIRole R> void decide(TownQuotes &qts);
+    using Kernel = void (AI::*)(TownQuotes &qts);
+    static const EnumArray<Kernel, AIRole> kernels; // decision kernel specialized for each role
 
 public:
-    AI(Traveler &tvl, const EnumArray<double, DecisionCriteria> &dcC, const GoodInfoContainer &gsI, AIRole rl);
-    AI(Traveler &tvl) : AI(tvl, Settings::aIDecisionCriteria(), {}, Settings::aIRole()) {}
-    AI(Traveler &tvl, const AI &p) : AI(tvl, p.decisionCriteria, p.goodsInfo, p.role) {}
+    AI(Traveler &tvl, const std::shared_ptr<const EnumArray<double, DecisionCriteria>> &dcC,
+       const std::shared_ptr<std::vector<GoodInfo>> &gsI, const boost::dynamic_bitset<> &knn,
+       const boost::dynamic_bitset<> &ond, AIRole rl);
+    AI(Traveler &tvl)
+        : AI(tvl, Settings::aIDecisionCriteria(), std::make_shared<std::vector<GoodInfo>>(), {}, {},
+             Settings::aIRole()) {}
+    AI(Traveler &tvl, const AI &p) : AI(tvl, p.decisionCriteria, p.goodsInfo, p.known, p.owned, p.role) {}
     AI(Traveler &tvl, const Save::AI *ldAI);
     flatbuffers::Offset<Save::AI> save(flatbuffers::FlatBufferBuilder &b) const;
     AIRole getRole() const { return role; }
+    static double attackScore(const std::vector<Good> &eqpmt, const EnumArray<unsigned int, Stat> &sts);
+    static double defenseScore(const std::vector<Good> &eqpmt, const EnumArray<unsigned int, Stat> &sts);
     FightChoice choice();
     Traveler *target(const std::unordered_set<Traveler *> &enms) const;
     Traveler *lootTarget(const std::unordered_set<Traveler *> &enms);
     void loot();
+    void ambush(std::vector<Traveler *> tgts);
     void update(unsigned int elTm);
+    bool decisionDue() const;
+    int decisionWait() const { return decisionCounter; }
+    void decide(TownQuotes &qts);
+    void refreshNearby();
 };
 
 #endif // AI_H
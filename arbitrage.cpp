@@ -0,0 +1,117 @@
+/*
+ * This file is part of Camels.
+ *
+ * Camels is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Camels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Camels.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * © Tom Rodgers notaraptor@gmail.com 2017-2019
+ */
+#include "arbitrage.hpp"
+
+#include "town.hpp"
+
+void ArbitrageTable::rescan(unsigned int fId, const std::vector<Town> &tns, const RouteTable &rtTbl) {
+    // Find lowest and highest price for given good within each group of towns linked by routes, keeping the group with
+    // the widest margin so that buy and sell towns can reach each other.
+    std::vector<Arbitrage> groups;    // lowest and highest price in each group
+    std::vector<const Town *> firsts; // first town found in each group
+    for (auto &tn : tns) {
+        auto gd = tn.getProperty().good(fId);
+        if (!gd) continue;
+        double price = gd->price();
+        size_t i = 0;
+        while (i < firsts.size() && rtTbl.distance(firsts[i], &tn) == RouteTable::unreachable) ++i;
+        if (i == firsts.size()) {
+            // Town is in a new group.
+            firsts.push_back(&tn);
+            groups.push_back({&tn, &tn, price, price});
+            continue;
+        }
+        Arbitrage &group = groups[i];
+        if (price < group.buyPrice) {
+            group.buyTown = &tn;
+            group.buyPrice = price;
+        }
+        if (price > group.sellPrice) {
+            group.sellTown = &tn;
+            group.sellPrice = price;
+        }
+    }
+    Arbitrage &route = routes[fId];
+    route = Arbitrage();
+    for (auto &group : groups)
+        if (!route.buyTown || group.sellPrice - group.buyPrice > route.sellPrice - route.buyPrice) route = group;
+}
+
+void ArbitrageTable::clear() {
+    epochs.clear();
+    routes.clear();
+}
+
+void ArbitrageTable::refresh(const std::vector<Town> &tns, const RouteTable &rtTbl) {
+    // Update routes for goods in towns whose prices changed since last refresh.
+    if (epochs.size() != tns.size()) {
+        // Towns were replaced, rebuild table.
+        clear();
+        epochs.resize(tns.size());
+    }
+    std::unordered_set<unsigned int> changed, stale; // goods with a changed price and goods whose extreme worsened
+    for (size_t i = 0; i < tns.size(); ++i) {
+        auto &tn = tns[i];
+        auto &ppt = tn.getProperty();
+        unsigned int epoch = ppt.getPriceEpoch();
+        if (epochs[i] == epoch) continue;
+        epochs[i] = epoch;
+        ppt.forGood([&tn, &changed, &stale, this](const Good &gd) {
+            unsigned int fId = gd.getFullId();
+            changed.insert(fId);
+            if (stale.count(fId)) return;
+            Arbitrage &route = routes[fId];
+            double price = gd.price();
+            if ((route.buyTown == &tn && price > route.buyPrice) ||
+                (route.sellTown == &tn && price < route.sellPrice)) {
+                // Town held lowest or highest price and moved away from it, rescan good.
+                stale.insert(fId);
+                return;
+            }
+            if (!route.buyTown || price <= route.buyPrice) {
+                route.buyTown = &tn;
+                route.buyPrice = price;
+            }
+            if (!route.sellTown || price >= route.sellPrice) {
+                route.sellTown = &tn;
+                route.sellPrice = price;
+            }
+        });
+    }
+    for (auto fId : stale) rescan(fId, tns, rtTbl);
+    for (auto fId : changed) {
+        // Set margin and distance of changed routes.
+        Arbitrage &route = routes[fId];
+        route.distance = rtTbl.distance(route.buyTown, route.sellTown);
+        if (route.distance == RouteTable::unreachable) {
+            // New lowest or highest price is in a town cut off from the other, find best pair of linked towns.
+            rescan(fId, tns, rtTbl);
+            route.distance = rtTbl.distance(route.buyTown, route.sellTown);
+        }
+        auto gd = route.buyTown->getProperty().good(fId);
+        double margin = route.sellPrice - route.buyPrice, carry = gd->getCarry();
+        route.marginPerWeight = carry > 0 ? margin / carry : margin;
+    }
+}
+
+const Arbitrage *ArbitrageTable::route(unsigned int fId) const {
+    auto rtIt = routes.find(fId);
+    if (rtIt == end(routes)) return nullptr;
+    return &rtIt->second;
+}
@@ -0,0 +1,48 @@
+/*
+ * This file is part of Camels.
+ *
+ * Camels is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Camels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Camels.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * © Tom Rodgers notaraptor@gmail.com 2017-2019
+ */
+#ifndef ARBITRAGE_H
+#define ARBITRAGE_H
+
+#include <cmath>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+class RouteTable;
+class Town;
+
+struct Arbitrage {
+    const Town *buyTown = nullptr, *sellTown = nullptr; // towns with lowest and highest price for good
+    double buyPrice = 0, sellPrice = 0;
+    double marginPerWeight = 0; // difference between sell and buy price per unit weight
+    double distance = 0;        // world distance along shortest path from buy town to sell town
+};
+
+class ArbitrageTable {
+    std::vector<unsigned int> epochs;                    // price epoch of each town when table was last refreshed
+    std::unordered_map<unsigned int, Arbitrage> routes; // best route by full id
+    void rescan(unsigned int fId, const std::vector<Town> &tns, const RouteTable &rtTbl);
+
+public:
+    void clear();
+    void refresh(const std::vector<Town> &tns, const RouteTable &rtTbl);
+    const Arbitrage *route(unsigned int fId) const;
+};
+
+#endif // ARBITRAGE_H
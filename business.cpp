@@ -25,7 +25,7 @@ Business::Business(unsigned int i, unsigned int m, const std::string &nm, bool c
       frequencyFactors(fFs) {}
 
 Business::Business(const Save::Business *svBsn)
-    : id(svBsn->id()), mode(svBsn->mode()), name(svBsn->name()->str()), area(svBsn->area()),
+    : id(svBsn->id()), mode(svBsn->mode()), name(svBsn->name()->str()), area(static_cast<Scalar>(svBsn->area())),
       canSwitch(svBsn->canSwitch()), requireCoast(svBsn->requireCoast()), keepMaterial(svBsn->keepMaterial()),
       frequency(svBsn->frequency()), reclaimFactor(svBsn->reclaimFactor()) {
     auto ldRequirements = svBsn->requirements();
@@ -60,7 +60,7 @@ void Business::setArea(double a) {
     if (area > 0) {
         for (auto &ip : inputs) ip.setAmount(ip.getAmount() * a / area);
         for (auto &op : outputs) op.setAmount(op.getAmount() * a / area);
-        area = a;
+        area = static_cast<Scalar>(a);
     }
 }
 
@@ -134,7 +134,7 @@ void Business::setFactor(double ft, const Property &inv, std::unordered_map<unsi
             // Factor is too large for input.
             maxFactor = std::min(inputFactor, maxFactor);
     }
-    factor = maxFactor;
+    factor = static_cast<Scalar>(maxFactor);
     if (factor < 0 || std::isnan(factor))
         throw std::runtime_error(std::to_string(factor) + " factor for " + name);
 }
@@ -149,7 +149,7 @@ void Business::run(Property &inv, const std::unordered_map<unsigned int, Conflic
             greatestConflict = std::max(cfctIt->second.count, greatestConflict);
     }
     // Divide factor by greatest conflict.
-    if (greatestConflict) factor /= static_cast<double>(greatestConflict);
+    if (greatestConflict) factor /= static_cast<Scalar>(greatestConflict);
     if (factor > 0) {
         // Run business.
         auto lastInputId = inputs.back().getGoodId(); // inputs which determine material
@@ -37,7 +37,7 @@ struct Conflict;
 class Business {
     unsigned int id, mode;
     std::string name;
-    double area;    // in uncia
+    Scalar area;    // in uncia
     bool canSwitch; // whether able to switch between modes
     bool requireCoast;
     bool keepMaterial;                            // whether outputs get input as material
@@ -45,7 +45,7 @@ class Business {
     std::vector<Good> reclaimables;               // goods which will be reclaimed when business is demolished
     std::vector<Good> inputs;                     // goods needed every production cycle
     std::vector<Good> outputs;                    // goods created every production cycle
-    double factor;                                // factor based on area and available inputs for production
+    Scalar factor;                                // factor based on area and available inputs for production
     double frequency = 0;                         // area of business per unit of population
     EnumArray<double, TownType> frequencyFactors; // factors for frequency in different town types
     double reclaimFactor = 0.7;                   // portion of requirements that can be reclaimed
@@ -79,7 +79,7 @@ public:
     void setRequirements(const std::vector<Good> &rqs) { requirements = rqs; }
     void setInputs(const std::vector<Good> &ips) { inputs = ips; }
     void setOutputs(const std::vector<Good> &ops) { outputs = ops; }
-    void setFactor(double ft) { factor = ft; }
+    void setFactor(double ft) { factor = static_cast<Scalar>(ft); }
     void setFactor(double ft, const Property &inv, std::unordered_map<unsigned int, Conflict> &cfcts);
     void setFrequency(double fq) { frequency = fq; }
     void takeRequirements(Property &inv, double a);
@@ -96,4 +96,12 @@ struct BusinessPlan {
     bool build;
 };
 
+struct PlanTemplate {
+    unsigned int epoch = 0;     // price epoch of property when template was made
+    bool available = false;     // whether all inputs are available
+    double profit = 0;          // profit per uncia at current prices
+    std::vector<Good> request;  // goods needed per uncia, set to cheapest materials
+    std::vector<double> prices; // prices of cheapest materials, stopping at first unavailable good
+};
+
 #endif // BUSINESS_H
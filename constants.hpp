@@ -34,5 +34,17 @@ const double kTravelerCarry = -16;
 const size_t kStatusChanceCount = 3;
 const size_t kFontCount = 5; // number of fonts used to display text
 const int kMaxGoodImageSize = 51;
+const unsigned int kHoursPerDay = 24;
+const size_t kRawPricePoints = 24;    // number of property updates kept in each good's price history
+const size_t kHourlyPricePoints = 24; // number of hourly averages kept in each good's price history
+const size_t kDailyPricePoints = 14;  // number of daily averages kept in each good's price history
+
+// Type used to store economy state such as good amounts, demand, and business areas. Define FLOAT_ECONOMY to store
+// as float; arithmetic is still done in double and saves still hold doubles.
+#ifdef FLOAT_ECONOMY
+using Scalar = float;
+#else
+using Scalar = double;
+#endif
 
 #endif
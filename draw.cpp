@@ -37,6 +37,11 @@ int Position::distSq(const Position &pos) const {
     return (dist.x) * (dist.x) + (dist.y) * (dist.y);
 }
 
+double Position::distance(const Position &pos) const {
+    // Return distance to given position in world coordinates, independent of screen placement.
+    return std::hypot(pos.latitude - latitude, pos.longitude - longitude);
+}
+
 bool Position::stepToward(const Position &pos, double tm) {
     // Take a step toward given position for given time. Return false if position reached otherwise return true.
     double dlt = pos.latitude - latitude;
@@ -42,6 +42,7 @@ public:
     double getLatitude() const { return latitude; }
     const SDL_Point &getPoint() const { return point; }
     int distSq(const Position &pos) const;
+    double distance(const Position &pos) const;
     void setLongitude(double lng) { longitude = lng; }
     void setLatitude(double ltt) { latitude = ltt; }
     void place(const SDL_Point &ofs, double s);
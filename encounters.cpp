@@ -0,0 +1,73 @@
+/*
+ * This file is part of Camels.
+ *
+ * Camels is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Camels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Camels.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * © Tom Rodgers notaraptor@gmail.com 2017-2019
+ */
+
+#include "encounters.hpp"
+
+double EncounterQueue::meetDelay(const Position &frm, const Position &to, const Position &at) {
+    // Return milliseconds after leaving frm toward to until within attack distance of at, or infinity if never.
+    double range = std::sqrt(Settings::getAttackDistSq()) / Settings::getScale(); // attack distance in degrees
+    double dlt = to.getLatitude() - frm.getLatitude(), dlg = to.getLongitude() - frm.getLongitude();
+    double length = std::sqrt(dlt * dlt + dlg * dlg);
+    double wLt = frm.getLatitude() - at.getLatitude(), wLg = frm.getLongitude() - at.getLongitude();
+    double startSq = wLt * wLt + wLg * wLg - range * range;
+    if (startSq <= 0) return 0;
+    if (length == 0) return std::numeric_limits<double>::infinity();
+    // Solve for distance along leg where squared distance to at equals squared range.
+    double b = (wLt * dlt + wLg * dlg) / length;
+    double disc = b * b - startSq;
+    if (disc < 0) return std::numeric_limits<double>::infinity();
+    double entry = -b - std::sqrt(disc);
+    if (entry < 0 || entry > length) return std::numeric_limits<double>::infinity();
+    // Travelers move one degree per day length.
+    return entry * Settings::getDayLength();
+}
+
+void EncounterQueue::schedule(Traveler *atk, Traveler *tgt, double dly) {
+    // Add encounter between given travelers after given delay.
+    encounters.push_back({clock + dly, atk, tgt});
+    std::push_heap(begin(encounters), end(encounters), std::greater<>());
+}
+
+void EncounterQueue::cancel(const Traveler *tvl) {
+    // Remove encounters involving given traveler.
+    auto rmIt = std::remove_if(begin(encounters), end(encounters),
+                               [tvl](const Encounter &ec) { return ec.attacker == tvl || ec.target == tvl; });
+    if (rmIt == end(encounters)) return;
+    encounters.erase(rmIt, end(encounters));
+    std::make_heap(begin(encounters), end(encounters), std::greater<>());
+}
+
+std::vector<Ambush> EncounterQueue::advance(unsigned int elTm) {
+    // Advance clock by given time and return targets of encounters which have occurred by attacker, attackers with
+    // earliest encounters first.
+    clock += elTm;
+    std::vector<Ambush> due;
+    while (!encounters.empty() && encounters.front().time <= clock) {
+        std::pop_heap(begin(encounters), end(encounters), std::greater<>());
+        auto &ec = encounters.back();
+        // Group targets by attacker so that attacker may choose among all of them.
+        auto abIt = std::find_if(begin(due), end(due), [&ec](const Ambush &ab) { return ab.attacker == ec.attacker; });
+        if (abIt == end(due))
+            due.push_back({ec.attacker, {ec.target}});
+        else
+            abIt->targets.push_back(ec.target);
+        encounters.pop_back();
+    }
+    return due;
+}
@@ -0,0 +1,56 @@
+/*
+ * This file is part of Camels.
+ *
+ * Camels is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Camels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Camels.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * © Tom Rodgers notaraptor@gmail.com 2017-2019
+ */
+
+#ifndef ENCOUNTERS_H
+#define ENCOUNTERS_H
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "draw.hpp"
+#include "settings.hpp"
+
+class Traveler;
+
+struct Encounter {
+    double time;        // game time in milliseconds when target comes within attack distance
+    Traveler *attacker; // traveler which may ambush target
+    Traveler *target;
+    bool operator>(const Encounter &other) const { return time > other.time; }
+};
+
+struct Ambush {
+    Traveler *attacker;              // traveler which may ambush one of targets
+    std::vector<Traveler *> targets; // travelers which came within attack distance of attacker at the same time
+};
+
+class EncounterQueue {
+    double clock = 0;                  // milliseconds of unpaused game time elapsed
+    std::vector<Encounter> encounters; // heap of predicted encounters, earliest on top
+
+public:
+    static double meetDelay(const Position &frm, const Position &to, const Position &at);
+    void schedule(Traveler *atk, Traveler *tgt, double dly);
+    void cancel(const Traveler *tvl);
+    std::vector<Ambush> advance(unsigned int elTm);
+};
+
+#endif // ENCOUNTERS_H
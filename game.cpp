@@ -25,6 +25,11 @@ Game::Game()
                                                            screenRect.w, screenRect.h, SDL_WINDOW_BORDERLESS)),
       screen(SDL_CreateRenderer(window.get(), -1, SDL_RENDERER_ACCELERATED)),
       travelersCheckCounter(Settings::travelersCheckCounter()) {
+    gameData.arbitrage = &arbitrage;
+    gameData.routeTable = &routeTable;
+    gameData.travelerGrid = &travelerGrid;
+    gameData.encounters = &encounters;
+    gameData.names = &names;
     player = std::make_unique<Player>(*this);
     player->setState(State::starting);
     std::cout << "Creating Game" << std::endl;
@@ -496,6 +501,41 @@ void Game::loadTowns(sqlite3 *cn, LoadBar &ldBr, SDL_Texture *frzTx) {
         ldBr.draw(screen.get());
         SDL_RenderPresent(screen.get());
     }
+    routeTable.build(towns);
+    findRegions();
+}
+
+void Game::findRegions() {
+    // Find towns within AI town range of each town breadth first over route graph and store them as compressed
+    // sparse rows.
+    unsigned int range = Settings::getAITownRange();
+    regionTowns.clear();
+    regionOffsets.assign(1, 0);
+    std::vector<bool> visited(towns.size()); // towns already in current row
+    auto visit = [&visited, this](size_t nbIdx) {
+        if (visited[nbIdx]) return;
+        visited[nbIdx] = true;
+        regionTowns.push_back(&towns[nbIdx]);
+    };
+    for (size_t t = 0; t < towns.size(); ++t) {
+        size_t rowBegin = regionTowns.size(), levelBegin = rowBegin;
+        visited[t] = true;
+        if (range)
+            for (auto nbIdx : routeTable.neighbors(t)) visit(nbIdx);
+        for (unsigned int step = 1; step < range && levelBegin < regionTowns.size(); ++step) {
+            // Add neighbors of towns found in last step.
+            size_t levelEnd = regionTowns.size();
+            for (size_t i = levelBegin; i < levelEnd; ++i)
+                for (auto nbIdx : routeTable.neighbors(routeTable.index(regionTowns[i]))) visit(nbIdx);
+            levelBegin = levelEnd;
+        }
+        // Clear visited towns for next row.
+        visited[t] = false;
+        for (size_t i = rowBegin; i < regionTowns.size(); ++i) visited[routeTable.index(regionTowns[i])] = false;
+        regionOffsets.push_back(regionTowns.size());
+    }
+    for (size_t i = 0; i < towns.size(); ++i)
+        towns[i].setRegion({regionTowns.data() + regionOffsets[i], regionTowns.data() + regionOffsets[i + 1]});
 }
 
 const std::vector<Nation> &Game::newGame() {
@@ -553,6 +593,7 @@ void Game::loadGame(const fs::path &p) {
     if (file.is_open()) {
         aITravelers.clear();
         towns.clear();
+        arbitrage.clear();
         file.seekg(0, file.end);
         std::streamsize length = file.tellg();
         file.seekg(0, file.beg);
@@ -597,12 +638,20 @@ void Game::loadGame(const fs::path &p) {
             loadBar.draw(screen.get());
             SDL_RenderPresent(screen.get());
         }
-        player->loadTraveler(game->playerTraveler(), nations, towns, gameData);
+        routeTable.build(towns);
+        findRegions();
+        // Restore AI archetypes from the first AI loaded with each.
+        Settings::clearAIArchetypes();
         auto lTravelers = game->aITravelers();
         std::transform(lTravelers->begin() + 1, lTravelers->end(), std::back_inserter(aITravelers), [this](auto ldTvl) {
             return std::make_unique<Traveler>(ldTvl, nations, towns, gameData);
         });
-        for (auto &t : aITravelers) t->startAI();
+        for (auto &t : aITravelers) t->addToTown();
+        // Load player after AI travelers so that bandits waiting in towns are known when predicting encounters.
+        player->loadTraveler(game->playerTraveler(), nations, towns, gameData, p);
+        // Predict encounters of travelers which were moving when game was saved.
+        for (auto &t : aITravelers)
+            if (t->getMoving()) t->scheduleEncounters();
         place();
     }
 }
@@ -630,6 +679,55 @@ void Game::handleEvents() {
     }
 }
 
+void Game::decide() {
+    // Make due AI decisions, nearest to player first, until decision budget for frame is spent. Remaining AIs stay
+    // due and decide in later frames, ranking nearer the longer they wait.
+    std::vector<std::pair<double, Traveler *>> due; // rank and traveler of each due AI
+    auto playerTraveler = player->getTraveler();
+    double aging = Settings::getAIDecisionAging();
+    for (auto &t : aITravelers)
+        if (t->decisionDue()) {
+            // Divide distance to player by time waited since decision came due so that distant AIs can't starve.
+            double distance = playerTraveler ? std::sqrt(t->getPosition().distSq(playerTraveler->getPosition())) : 1;
+            due.emplace_back(distance / (1 + std::max(t->decisionWait(), 0) / aging), t.get());
+        }
+    if (due.empty()) return;
+    // Choose as many AIs as the cap allows and the budget is expected to fit from recent decision times.
+    size_t decisionsMax = std::min(due.size(), Settings::getAIDecisionsMax());
+    if (decisionCost > 0)
+        decisionsMax = std::min(
+            std::max(static_cast<size_t>(Settings::getAIDecisionBudget() / decisionCost), size_t{1}), decisionsMax);
+    // Choose highest ranked AIs.
+    std::partial_sort(begin(due), begin(due) + static_cast<std::ptrdiff_t>(decisionsMax), end(due),
+                      [](const auto &a, const auto &b) { return a.first < b.first; });
+    std::vector<Traveler *> chosen;
+    chosen.reserve(decisionsMax);
+    for (size_t i = 0; i < decisionsMax; ++i) chosen.push_back(due[i].second);
+    // Group only chosen AIs in the same town, in order of each town's best ranked AI, so that each town's goods are
+    // quoted once for its whole group. Within a town, group AIs by role so each role's decision kernel runs back to
+    // back.
+    std::unordered_map<const Town *, size_t> townRanks;
+    for (auto tvl : chosen) townRanks.emplace(tvl->town(), townRanks.size());
+    std::stable_sort(begin(chosen), end(chosen), [&townRanks](const Traveler *a, const Traveler *b) {
+        return std::make_pair(townRanks.at(a->town()), a->getAIRole()) <
+               std::make_pair(townRanks.at(b->town()), b->getAIRole());
+    });
+    TownQuotes quotes;
+    auto start = std::chrono::steady_clock::now();
+    auto budget = std::chrono::microseconds(Settings::getAIDecisionBudget());
+    size_t decided = 0;
+    for (auto tvl : chosen) {
+        tvl->decide(quotes);
+        ++decided;
+        // Stop early if decisions took much longer than expected.
+        if (std::chrono::steady_clock::now() - start > budget) break;
+    }
+    // Average time of decisions into recent decision cost.
+    double cost = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() /
+                  static_cast<double>(decided);
+    decisionCost = decisionCost > 0 ? (decisionCost * 3 + cost) / 4 : cost;
+}
+
 void Game::update() {
     currentTime = SDL_GetTicks();
     unsigned int elapsed = currentTime - lastTime;
@@ -640,6 +738,13 @@ void Game::update() {
             t->update(elapsed);
             t->place(offset, scale);
         }
+        // Let bandits ambush travelers whose predicted encounters have occurred.
+        for (auto &ab : encounters.advance(elapsed)) ab.attacker->ambush(ab.targets);
+        decide();
+        // Clear trades ordered during traveler updates.
+        for (auto &t : towns) t.clearOrders();
+        // Refresh trade routes of goods whose prices changed.
+        arbitrage.refresh(towns, routeTable);
         if (!aITravelers.empty()) {
             travelersCheckCounter += elapsed;
             if (travelersCheckCounter > 0) {
@@ -689,6 +794,12 @@ void Game::generateRoutes() {
             if (t.getId() < n->getId())
                 // Only fill routes one way.
                 routes.push_back(Route(&t, n));
+    routeTable.build(towns);
+    // Route distances changed, rebuild arbitrage table on next refresh.
+    arbitrage.clear();
+    findRegions();
+    // Regions were found again, so nearby towns of AI travelers refer to freed rows.
+    for (auto &t : aITravelers) t->refreshNearby();
 }
 
 void Game::saveData() {
@@ -715,6 +826,14 @@ void Game::saveData() {
     conn = nullptr;
 }
 
+fs::path Game::savePath(const std::string &tvlName) {
+    // Return path of file game of traveler with given name is saved to.
+    fs::path path("save");
+    path /= tvlName;
+    path.replace_extension("sav");
+    return path;
+}
+
 void Game::saveGame() {
     // Save the game.
     if (!player->hasTraveler()) std::cout << "Tried to save game with no player traveler" << std::endl;
@@ -727,12 +846,11 @@ void Game::saveGame() {
         aITravelers.size(), [this, &builder](size_t i) { return aITravelers[i]->save(builder); });
     auto game = Save::CreateGame(builder, sTowns, sRoutes, player->getTraveler()->save(builder), sAITravelers);
     builder.Finish(game);
-    fs::path path("save");
-    path /= player->getTraveler()->getName();
-    path.replace_extension("sav");
+    auto path = savePath(player->getTraveler()->getName());
     std::ofstream file(path.string(), std::ofstream::binary);
     if (file.is_open())
         file.write(reinterpret_cast<const char *>(builder.GetBufferPointer()), builder.GetSize());
+    player->getTraveler()->saveHistory(path);
 }
 
 std::vector<TextBox *> Game::getTownBoxes() const {
@@ -749,6 +867,7 @@ std::unique_ptr<Traveler> Game::createPlayerTraveler(size_t nId, std::string n)
     traveler->addToTown();
     traveler->place(offset, scale);
     for (auto &sG : Settings::getPlayerStartingGoods()) traveler->create(sG.first, sG.second);
+    if (Settings::getLogHistory()) traveler->startHistory(savePath(n), false);
     return traveler;
 }
 
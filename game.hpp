@@ -21,22 +21,28 @@
 #define GAME_H
 
 #include <algorithm>
+#include <chrono>
 #include <fstream>
 #include <iostream>
 #include <map>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <SDL2/SDL_image.h>
 #include <sqlite3.h>
 
+#include "arbitrage.hpp"
 #include "business.hpp"
+#include "encounters.hpp"
 #include "loadbar.hpp"
 #include "nation.hpp"
 #include "player.hpp"
+#include "routetable.hpp"
 #include "textbox.hpp"
 #include "town.hpp"
 #include "traveler.hpp"
+#include "travelergrid.hpp"
 
 namespace sql {
 struct Deleter {
@@ -83,18 +89,29 @@ class Game {
     int mapTextureRowCount, mapTextureColumnCount; // number of columns in map textures matrix
     sdl::Texture mapTexture;                       // texture for drawing map on screen at current position
     unsigned int lastTime = 0, currentTime;
+    double decisionCost = 0; // recent average time of an AI decision in microseconds, 0 until measured
     std::vector<Nation> nations;
     std::vector<Town> towns;
     std::vector<Route> routes;
+    std::vector<Town *> regionTowns;   // towns within AI town range of each town, in rows
+    std::vector<size_t> regionOffsets; // index in region towns of start of each town's row
     std::vector<sdl::Surface> goodImages;
     GameData gameData;
+    ArbitrageTable arbitrage;
+    RouteTable routeTable;
+    TravelerGrid travelerGrid;
+    EncounterQueue encounters;
+    NameTable names;
     std::vector<std::unique_ptr<Traveler>> aITravelers;
     int travelersCheckCounter;
     std::unique_ptr<Player> player;
     void loadData(sqlite3 *cn);
     void loadTowns(sqlite3 *cn, LoadBar &ldBr, SDL_Texture *frzTx);
+    void findRegions();
+    static fs::path savePath(const std::string &tvlName);
     void renderMapTexture();
     void handleEvents();
+    void decide();
     void update();
     void draw();
 
@@ -22,9 +22,11 @@
 Good::Good(const Save::Good *ldGd)
     : goodId(ldGd->goodId()), materialId(ldGd->materialId()), fullId(ldGd->fullId()),
       goodName(ldGd->goodName()->str()), materialName(ldGd->materialName()->str()), fullName(completeName()),
-      amount(ldGd->amount()), perish(ldGd->perish()), carry(ldGd->carry()),
-      consumptionRate(ldGd->consumptionRate()), demandSlope(ldGd->demandSlope()),
-      demandIntercept(ldGd->demandIntercept()), minPrice(demandIntercept / Settings::getMinPriceDivisor()),
+      amount(static_cast<Scalar>(ldGd->amount())), perish(static_cast<Scalar>(ldGd->perish())),
+      carry(static_cast<Scalar>(ldGd->carry())), consumptionRate(static_cast<Scalar>(ldGd->consumptionRate())),
+      demandSlope(static_cast<Scalar>(ldGd->demandSlope())),
+      demandIntercept(static_cast<Scalar>(ldGd->demandIntercept())),
+      minPrice(demandIntercept / static_cast<Scalar>(Settings::getMinPriceDivisor())),
       measure(ldGd->measure()->str()), split(!measure.empty()), lastAmount(amount) {}
 
 flatbuffers::Offset<Save::Good> Good::save(flatbuffers::FlatBufferBuilder &b) const {
@@ -81,7 +83,7 @@ std::string Good::logEntry() const {
 
 double Good::price(double qtt) const {
     // Get the price offered when selling the given quantity.
-    return std::max(demandIntercept - demandSlope * (amount + qtt / 2), minPrice) * qtt;
+    return std::max<double>(demandIntercept - demandSlope * (amount + qtt / 2), minPrice) * qtt;
 }
 
 double Good::price() const {
@@ -91,8 +93,8 @@ double Good::price() const {
 
 double Good::cost(double &qtt) const {
     // Get the cost to buy the given quantity, or available amount if less.
-    qtt = std::min(amount, qtt);
-    return std::max(demandIntercept - demandSlope * (amount - qtt / 2), minPrice) * qtt;
+    qtt = std::min<double>(amount, qtt);
+    return std::max<double>(demandIntercept - demandSlope * (amount - qtt / 2), minPrice) * qtt;
 }
 
 double Good::quantity(double cst, double &exc) const {
@@ -143,16 +145,16 @@ double Good::quota(double prc) const {
 
 void Good::setConsumption(const std::array<double, 3> &cnsptn) {
     // Assign the given three values to consumption, demand slope, and demand intercept.
-    consumptionRate = cnsptn[0];
-    demandSlope = cnsptn[1];
-    demandIntercept = cnsptn[2];
+    consumptionRate = static_cast<Scalar>(cnsptn[0]);
+    demandSlope = static_cast<Scalar>(cnsptn[1]);
+    demandIntercept = static_cast<Scalar>(cnsptn[2]);
 }
 
 void Good::scale(double ppl) {
     // Assign consumption to match given population.
     if (ppl) {
-        demandSlope /= ppl;
-        consumptionRate *= ppl;
+        demandSlope = static_cast<Scalar>(demandSlope / ppl);
+        consumptionRate = static_cast<Scalar>(consumptionRate * ppl);
     } else
         consumptionRate = 0;
 }
@@ -176,11 +178,11 @@ void Good::take(Good &gd) {
         perishCounters.pop_back();
         if (pC.amount > movedAmount) {
             // Perish counter is enough to make change and stay around.
-            pC.amount -= movedAmount;
+            pC.amount -= static_cast<Scalar>(movedAmount);
             // Put perish counter back less amount moved.
             perishCounters.push_back(pC);
             // Taken perish counter has just the amount taken.
-            pC.amount = movedAmount;
+            pC.amount = static_cast<Scalar>(movedAmount);
             gd.perishCounters.push_front(pC);
             movedAmount = 0;
         } else {
@@ -202,14 +204,14 @@ void Good::put(Good &gd) {
 void Good::use(double amt) {
     // Uses up the given amount of this good.
     if (amt < 0) return;
-    amount = std::max(amount - amt, 0.);
+    amount = static_cast<Scalar>(std::max(amount - amt, 0.));
     while (amt > 0 && !perishCounters.empty()) {
         // Amount and amt will count down as perish counters are used.
         PerishCounter pC = perishCounters.back();
         perishCounters.pop_back();
         if (pC.amount > amt) {
             // Perish counter is enough to make change and stay around.
-            pC.amount -= amt;
+            pC.amount -= static_cast<Scalar>(amt);
             perishCounters.push_back(pC);
             amt = 0;
         } else {
@@ -222,8 +224,8 @@ void Good::use(double amt) {
 
 void Good::create(double amt) {
     // Newly creates the given amount of this good.
-    amount += amt;
-    if (amt > 0 && perish != 0) perishCounters.push_front({0, amt});
+    amount += static_cast<Scalar>(amt);
+    if (amt > 0 && perish != 0) perishCounters.push_front({0, static_cast<Scalar>(amt)});
     enforceMaximum();
     if (std::isnan(amount)) throw std::runtime_error(fullName + " amount is " + std::to_string(amount));
 }
@@ -233,7 +235,7 @@ void Good::update(unsigned int elTm, double dyLn) {
     lastAmount = amount;
     double consumed = consumptionRate * static_cast<double>(elTm) / dyLn;
     // Ensure we don't consume more than current amount.
-    consumed = std::min(amount, consumed);
+    consumed = std::min<double>(amount, consumed);
     if (consumed > 0)
         // Positive consumption uses goods.
         use(consumed);
@@ -251,8 +253,8 @@ void Good::update(unsigned int elTm, double dyLn) {
     perishCounters.erase(expired, perishCounters.end());
     // Add elapsed time to remaining counters.
     for (auto &pC : perishCounters) pC.time += elTm;
-    perished = std::min(amount, perished);
-    amount -= perished;
+    perished = std::min<double>(amount, perished);
+    amount -= static_cast<Scalar>(perished);
 }
 
 std::unique_ptr<MenuButton> Good::button(bool aS, BoxInfo &bI, Printer &pr) const {
@@ -289,7 +291,7 @@ void Good::updateButton(double oV, unsigned int rC, TextBox *btn) const {
     // Update amount shown on this material's button. Call only when offer value and request count are non-zero.
     std::string amountText;
     if (rC)
-        amountText = std::to_string(std::min(quantity(oV / rC * Settings::getTownProfit()), amount));
+        amountText = std::to_string(std::min<double>(quantity(oV / rC * Settings::getTownProfit()), amount));
     else
         amountText = std::to_string(amount);
     updateButton(amountText, btn);
@@ -297,13 +299,14 @@ void Good::updateButton(double oV, unsigned int rC, TextBox *btn) const {
 
 void Good::adjustDemand(double dDS) {
     // Change demand slope by parameter * demandIntercept.
-    demandSlope += dDS * demandIntercept;
-    demandSlope = std::max(0., demandSlope);
+    demandSlope += static_cast<Scalar>(dDS * demandIntercept);
+    demandSlope = std::max<Scalar>(0, demandSlope);
 }
 
 void Good::fixDemand(double m) {
     // Check if price goes too low when good is at maximum.
-    if (demandIntercept - demandSlope * m < minPrice) demandSlope = (demandIntercept - minPrice) / m;
+    if (demandIntercept - demandSlope * m < minPrice)
+        demandSlope = static_cast<Scalar>((demandIntercept - minPrice) / m);
 }
 
 void Good::saveDemand(unsigned long ppl, std::string &u) const {
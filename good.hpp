@@ -45,17 +45,18 @@ struct CombatStat {
 class Good {
     unsigned int goodId, materialId = 0, fullId = 0;
     std::string goodName, materialName, fullName;
-    double amount = 0, maximum /* maximum allowable amount */ = 0, perish /* shelf life in days */ = 0,
-           carry /* per-unit weight */ = 0, consumptionRate, demandSlope, demandIntercept, minPrice;
+    Scalar amount = 0, maximum /* maximum allowable amount */ = 0;
+    Scalar perish /* shelf life in days */ = 0, carry /* per-unit weight */ = 0;
+    Scalar consumptionRate, demandSlope, demandIntercept, minPrice;
     std::string measure;     // word used to measure good
     bool split;              // whether good can be split
     unsigned int shoots = 0; // good id of good this good shoots
     std::vector<CombatStat> combatStats;
-    double lastAmount = 0;
+    Scalar lastAmount = 0;
     SDL_Surface *image = nullptr;
     struct PerishCounter {
         int time;      // time until counter expires
-        double amount; // amount of good counter handles
+        Scalar amount; // amount of good counter handles
         bool operator<(const PerishCounter &b) const { return time < b.time; }
     };
     std::deque<PerishCounter> perishCounters;
@@ -68,16 +69,19 @@ public:
         : goodId(gId), goodName(gNm), measure(msr), shoots(aId) {} // constructor for loading from goods table
     Good(const Good &gd, const Good &mt, unsigned int fId, double pr, double cr)
         : goodId(gd.goodId), materialId(mt.goodId), fullId(fId), goodName(gd.goodName),
-          materialName(mt.goodName), fullName(completeName()), perish(pr), carry(cr), measure(gd.measure),
-          split(!measure.empty()) {} // constructor for loading from materials table
+          materialName(mt.goodName), fullName(completeName()), perish(static_cast<Scalar>(pr)),
+          carry(static_cast<Scalar>(cr)), measure(gd.measure), split(!measure.empty()) {
+    } // constructor for loading from materials table
     Good(const Good &gd, double amt)
-        : goodId(gd.goodId), goodName(gd.goodName), amount(amt), measure(gd.measure), split(!measure.empty()) {
-    } // constructor for business inputs and outputs
+        : goodId(gd.goodId), goodName(gd.goodName), amount(static_cast<Scalar>(amt)), measure(gd.measure),
+          split(!measure.empty()) {} // constructor for business inputs and outputs
     Good(unsigned int fId, const std::string &fNm, double amt, const std::vector<CombatStat> &cSs, SDL_Surface *img)
-        : fullId(fId), fullName(fNm), amount(amt), combatStats(cSs), image(img) {} // constructor for equipment
-    Good(unsigned int fId, double amt) : fullId(fId), amount(amt) {} // constructor for transfer goods
+        : fullId(fId), fullName(fNm), amount(static_cast<Scalar>(amt)), combatStats(cSs), image(img) {
+    } // constructor for equipment
+    Good(unsigned int fId, double amt)
+        : fullId(fId), amount(static_cast<Scalar>(amt)) {} // constructor for transfer goods
     Good(unsigned int fId, const std::string &fNm, double amt, const std::string &msr)
-        : fullId(fId), fullName(fNm), amount(amt), measure(msr), split(!measure.empty()) {
+        : fullId(fId), fullName(fNm), amount(static_cast<Scalar>(amt)), measure(msr), split(!measure.empty()) {
     } // constructor for trade goods
     Good(const Save::Good *ldGd);
     flatbuffers::Offset<Save::Good> save(flatbuffers::FlatBufferBuilder &b) const;
@@ -118,7 +122,7 @@ public:
     SDL_Surface *getImage() const { return image; }
     void setFullId(unsigned int fId) { fullId = fId; }
     void setFullName(const std::string &fNm) { fullName = fNm; }
-    void setAmount(double amt) { amount = amt; }
+    void setAmount(double amt) { amount = static_cast<Scalar>(amt); }
     void setMeasure(const std::string &msr) { measure = msr; }
     void setConsumption(const std::array<double, 3> &cnsptn);
     void setCombatStats(const std::vector<CombatStat> &cSs) { combatStats = cSs; }
@@ -137,8 +141,10 @@ public:
     void fixDemand(double m);
     void saveDemand(unsigned long ppl, std::string &u) const;
     std::string logEntry() const;
-    void setMaximum() { maximum = std::abs(consumptionRate) * Settings::getConsumptionSpaceFactor(); }
-    void setMaximum(double max) { maximum = std::max(maximum, max); }
+    void setMaximum() {
+        maximum = static_cast<Scalar>(std::abs(consumptionRate) * Settings::getConsumptionSpaceFactor());
+    }
+    void setMaximum(double max) { maximum = static_cast<Scalar>(std::max<double>(maximum, max)); }
     void setDemandSlope() { demandSlope = std::max((demandIntercept - minPrice) / maximum, demandSlope); }
     std::unique_ptr<MenuButton> button(bool aS, BoxInfo &bI, Printer &pr) const;
     void adjustDemandSlope(double dDS);
@@ -118,6 +118,8 @@ Player::Player(Game &g) : game(g), screenRect(Settings::getScreenRect()), printe
             bxInf.colors = traveler->town()->getNation()->getColors();
             pagers[2].buttons(traveler->town()->getProperty(), bxInf, printer,
                               [this](const Good &) { return [this](MenuButton *) { updateTradeButtons(); }; });
+            // Update buttons on first frame.
+            tradeInputs = {};
         },
         3};
     uIStates[State::storing] = {
@@ -256,17 +258,28 @@ Player::Player(Game &g) : game(g), screenRect(Settings::getScreenRect()), printe
             pagers[1].buttons(traveler->property(), bxInf, printer,
                               [](const Good &) { return [](MenuButton *) {}; });
             auto town = traveler->town();
-            auto &bids = town->getBids();
+            auto &bids = town->getBids().get<WageOrder>();
+            std::vector<Traveler *> bidders; // travelers bidding in town, cheapest first
             std::vector<std::string> names;
+            bidders.reserve(bids.size());
             names.reserve(bids.size());
-            std::transform(begin(bids), end(bids), std::back_inserter(names),
-                           [](const Contract &bd) { return bd.party->getName(); });
+            for (auto &bd : bids) {
+                bidders.push_back(bd.party);
+                names.push_back(bd.party->getName());
+            }
+            // Create hire button.
             pagers[2].addBox(std::make_unique<SelectButton>(
                 Settings::boxInfo(
                     {screenRect.w * 17 / 31, screenRect.h / 31, screenRect.w * 12 / 31, screenRect.h * 11 / 31},
                     names, town->getNation()->getColors(), BoxSizeType::big, SDLK_h,
-                    [](MenuButton *) {
-
+                    [this, bidders](MenuButton *btn) {
+                        int i = btn->getHighlightLine();
+                        if (i > -1) {
+                            // A bidder is highlighted.
+                            traveler->hire(bidders[static_cast<size_t>(i)]);
+                            setState(State::managing);
+                        } else
+                            btn->setClicked(false);
                     }),
                 printer));
         },
@@ -299,13 +312,28 @@ Player::Player(Game &g) : game(g), screenRect(Settings::getScreenRect()), printe
                 printer));
         }};
     uIStates[State::logging] = {
-        {Settings::boxInfo({screenRect.w * 8 / 9, screenRect.h - smallBoxFontHeight, 0, 0}, {"Close (L)og"},
+        {Settings::boxInfo({screenRect.w * 2 / 3, screenRect.h - smallBoxFontHeight, 0, 0}, {"(O)lder"},
+                           BoxSizeType::small, SDLK_o,
+                           [this](MenuButton *) {
+                               if ((logPage + 1) * Settings::getLogLength() < traveler->logCount()) ++logPage;
+                               setState(State::logging);
+                           }),
+         Settings::boxInfo({screenRect.w * 7 / 9, screenRect.h - smallBoxFontHeight, 0, 0}, {"(N)ewer"},
+                           BoxSizeType::small, SDLK_n,
+                           [this](MenuButton *) {
+                               if (logPage) --logPage;
+                               setState(State::logging);
+                           }),
+         Settings::boxInfo({screenRect.w * 8 / 9, screenRect.h - smallBoxFontHeight, 0, 0}, {"Close (L)og"},
                            BoxSizeType::small, SDLK_l, [this](MenuButton *) { setState(State::traveling); })},
         [this] {
+            // Read only the shown page of the log.
+            size_t pageLength = Settings::getLogLength(), pageEnd = traveler->logCount() - logPage * pageLength;
             pagers[0].addBox(std::make_unique<ScrollBox>(
                 traveler->boxInfo(
                     {screenRect.w / 15, screenRect.h * 2 / 15, screenRect.w * 28 / 31, screenRect.h * 11 / 15},
-                    traveler->getLogText(), BoxSizeType::small),
+                    traveler->logText(pageEnd > pageLength ? pageEnd - pageLength : 0, pageLength),
+                    BoxSizeType::small),
                 printer));
         }};
     uIStates[State::targeting] = {
@@ -407,14 +435,15 @@ Player::Player(Game &g) : game(g), screenRect(Settings::getScreenRect()), printe
     uIStates[State::dying] = {{}, [this] {
                                   pagers[0].addBox(std::make_unique<TextBox>(
                                       Settings::boxInfo({screenRect.w / 2, screenRect.h / 2, 0, 0},
-                                                        {traveler->getLogText().back(), "You have died."},
+                                                        {traveler->lastLogText(), "You have died."},
                                                         traveler->getNation()->getColors(), BoxSizeType::big),
                                       printer));
                               }};
 
     fs::path path{"save"};
     std::vector<std::string> saves;
-    for (auto &file : fs::directory_iterator{path}) saves.push_back(file.path().stem().string());
+    for (auto &file : fs::directory_iterator{path})
+        if (file.path().extension() == ".sav") saves.push_back(file.path().stem().string());
     uIStates[State::loading].boxesInfo.push_back(
         Settings::boxInfo({screenRect.w / 5, screenRect.h / 7, screenRect.w * 3 / 5, screenRect.h * 5 / 7},
                           saves, BoxSizeType::big, BoxBehavior::scroll, SDLK_l, [this, &path](MenuButton *btn) {
@@ -425,9 +454,12 @@ Player::Player(Game &g) : game(g), screenRect(Settings::getScreenRect()), printe
 }
 
 void Player::loadTraveler(const Save::Traveler *ldTvl, const std::vector<Nation> &nts, std::vector<Town> &tns,
-                          const GameData &gD) {
+                          const GameData &gD, const fs::path &svPath) {
     // Load the traveler for the player from save file.
     traveler = std::make_unique<Traveler>(ldTvl, nts, tns, gD);
+    traveler->addToTown();
+    if (traveler->getMoving()) traveler->scheduleEncounters();
+    if (Settings::getLogHistory()) traveler->startHistory(svPath, true);
 }
 
 void Player::prepFocus(FocusGroup g, int &i, int &s, std::vector<TextBox *> &fcbls) {
@@ -558,6 +590,7 @@ void Player::focusNext(FocusGroup g) {
 
 void Player::setState(State s) {
     // Change the UI state to s.
+    if (s != State::logging) logPage = 0;
     auto framerateText = framerateBox ? framerateBox->getText() : std::vector<std::string>{"Framerate:", ""};
     UIState newState = uIStates[s];
     pagers.clear();
@@ -922,8 +955,14 @@ void Player::requestGoods(size_t ofCnt, double ofVl) {
     if (ofCnt) traveler->divideExcess(excess, townProfit);
 }
 
+std::tuple<unsigned int, unsigned int, double> Player::currentTradeInputs() const {
+    return {traveler->town()->getProperty().getPriceEpoch(), traveler->property().getPriceEpoch(),
+            traveler->getPortion()};
+}
+
 void Player::updateTradeButtons() {
     std::apply(&Player::requestGoods, std::tuple_cat(std::tuple(this), offerGoods()));
+    tradeInputs = currentTradeInputs();
 }
 
 void Player::update(unsigned int elTm) {
@@ -939,7 +978,8 @@ void Player::update(unsigned int elTm) {
         }
         break;
     case State::trading:
-        updateTradeButtons();
+        // Update buttons only if prices, goods, or portion changed since buttons were last updated.
+        if (currentTradeInputs() != tradeInputs) updateTradeButtons();
         break;
     case State::fighting:
         if (!traveler->alive())
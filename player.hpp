@@ -57,8 +57,11 @@ class Player {
     enum class Direction { left, right, up, down };
     std::unordered_set<Direction> scroll;
     double modMultiplier = 1; // multiplier for values which depend on keymod state
+    std::tuple<unsigned int, unsigned int, double> tradeInputs; // town and traveler price epochs and portion
+                                                                // when trade buttons were last updated
     int focusBox = -1,        // index of box we are focusing across all pagers
         focusTown = -1;       // index of town currently focused
+    size_t logPage = 0;       // page of log shown, counting back from most recent events
     State state = State::starting, storedState = State::starting;
     EnumArray<UIState, State> uIStates;
     enum class FocusGroup { box, neighbor, town };
@@ -72,6 +75,7 @@ class Player {
     void handleClick(const SDL_MouseButtonEvent &b);
     std::pair<size_t, double> offerGoods();
     void requestGoods(size_t ofCnt, double ofVl);
+    std::tuple<unsigned int, unsigned int, double> currentTradeInputs() const;
     void updateTradeButtons();
 
 public:
@@ -82,7 +86,7 @@ public:
     const Traveler *getTraveler() const { return traveler.get(); }
     bool hasTraveler() const { return traveler.get(); }
     void loadTraveler(const Save::Traveler *ldTvl, const std::vector<Nation> &nts, std::vector<Town> &tns,
-                      const GameData &gD);
+                      const GameData &gD, const fs::path &svPath);
     void setState(State s);
     void place(const SDL_Point &ofs, double s) {
         if (traveler.get()) traveler->place(ofs, s);
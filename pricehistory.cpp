@@ -0,0 +1,41 @@
+/*
+ * This file is part of Camels.
+ *
+ * Camels is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Camels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Camels.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * © Tom Rodgers notaraptor@gmail.com 2017-2019
+ */
+#include "pricehistory.hpp"
+
+void PriceHistory::accumulate(const PricePoint &pnt, unsigned int bktLn, PricePoint &sum, unsigned int &cnt,
+                              const std::function<void(const PricePoint &)> &fn) {
+    // Add given point to sum of current bucket, first flushing average of bucket if point starts a new one.
+    if (cnt && pnt.time / bktLn != sum.time / bktLn) {
+        fn({sum.time / bktLn * bktLn, sum.amount / static_cast<Scalar>(cnt), sum.price / static_cast<Scalar>(cnt)});
+        cnt = 0;
+    }
+    if (!cnt) sum = {pnt.time, 0, 0};
+    sum.amount += pnt.amount;
+    sum.price += pnt.price;
+    ++cnt;
+}
+
+void PriceHistory::record(unsigned int tm, double amt, double prc, unsigned int dyLn) {
+    // Record a sample at given time in raw ring and fold it into hourly and daily averages.
+    PricePoint point{tm, static_cast<Scalar>(amt), static_cast<Scalar>(prc)};
+    raw.push(point);
+    accumulate(point, std::max(dyLn / kHoursPerDay, 1u), hourSum, hourCount,
+               [this](const PricePoint &pnt) { hourly.push(pnt); });
+    accumulate(point, std::max(dyLn, 1u), daySum, dayCount, [this](const PricePoint &pnt) { daily.push(pnt); });
+}
@@ -0,0 +1,67 @@
+/*
+ * This file is part of Camels.
+ *
+ * Camels is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Camels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Camels.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * © Tom Rodgers notaraptor@gmail.com 2017-2019
+ */
+#ifndef PRICEHISTORY_H
+#define PRICEHISTORY_H
+
+#include <algorithm>
+#include <array>
+#include <functional>
+
+#include "constants.hpp"
+
+struct PricePoint {
+    unsigned int time = 0; // game time in milliseconds at start of sample
+    Scalar amount = 0, price = 0;
+};
+
+template <size_t N>
+class PriceRing {
+    std::array<PricePoint, N> points;
+    size_t head = 0, count = 0; // index of oldest point and number of points held
+
+public:
+    void push(const PricePoint &pnt) {
+        points[(head + count) % N] = pnt;
+        if (count < N)
+            ++count;
+        else
+            head = (head + 1) % N;
+    }
+    size_t size() const { return count; }
+    const PricePoint &operator[](size_t idx) const { return points[(head + idx) % N]; } // oldest first
+    const PricePoint &back() const { return (*this)[count - 1]; }
+};
+
+class PriceHistory {
+    PriceRing<kRawPricePoints> raw;       // every property update
+    PriceRing<kHourlyPricePoints> hourly; // averages over each hour
+    PriceRing<kDailyPricePoints> daily;   // averages over each day
+    PricePoint hourSum, daySum;           // sums of samples in current hour and day
+    unsigned int hourCount = 0, dayCount = 0;
+    static void accumulate(const PricePoint &pnt, unsigned int bktLn, PricePoint &sum, unsigned int &cnt,
+                           const std::function<void(const PricePoint &)> &fn);
+
+public:
+    void record(unsigned int tm, double amt, double prc, unsigned int dyLn);
+    const PriceRing<kRawPricePoints> &getRaw() const { return raw; }
+    const PriceRing<kHourlyPricePoints> &getHourly() const { return hourly; }
+    const PriceRing<kDailyPricePoints> &getDaily() const { return daily; }
+};
+
+#endif // PRICEHISTORY_H
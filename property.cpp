@@ -79,6 +79,13 @@ double Property::amount(unsigned int gId) const {
                            [](double tt, auto &gd) { return tt + gd.getAmount(); });
 }
 
+std::unordered_map<unsigned int, double> Property::amounts() const {
+    // Returns total amount of each good id in one pass.
+    std::unordered_map<unsigned int, double> amts;
+    for (auto &gd : goods) amts[gd.getGoodId()] += gd.getAmount();
+    return amts;
+}
+
 double Property::maximum(unsigned int gId) const {
     auto gdRng = goods.get<GoodId>().equal_range(gId);
     return std::accumulate(gdRng.first, gdRng.second, 0.,
@@ -90,8 +97,21 @@ double Property::weight() const {
                            [](double w, const auto &gd) { return w + gd.weight(); });
 }
 
+const PriceHistory *Property::priceHistory(unsigned int fId) const {
+    auto phIt = priceHistories.find(fId);
+    if (phIt == end(priceHistories)) return nullptr;
+    return &phIt->second;
+}
+
 std::pair<const Good *, double> Property::cheapest(unsigned int gId) const {
     // Returns a pair containing the cheapest good of given good id and its price.
+    auto chpIt = cheapestGoods.find(gId);
+    if (chpIt == end(cheapestGoods)) return {nullptr, std::numeric_limits<double>::max()};
+    return {good(chpIt->second.first), chpIt->second.second};
+}
+
+void Property::refreshCheapest(unsigned int gId) {
+    // Find the cheapest material in stock of given good id. Call whenever amounts of good id change.
     auto rng = goods.get<GoodId>().equal_range(gId);
     const Good *cheapest = nullptr;
     double lowest = std::numeric_limits<double>::max();
@@ -104,35 +124,67 @@ std::pair<const Good *, double> Property::cheapest(unsigned int gId) const {
             }
         }
     });
-    return {cheapest, lowest};
+    if (cheapest)
+        cheapestGoods[gId] = {cheapest->getFullId(), lowest};
+    else
+        cheapestGoods.erase(gId);
+}
+
+void Property::refreshCheapest() {
+    // Find the cheapest material in stock of every good id in one pass over goods.
+    cheapestGoods.clear();
+    for (auto &gd : goods)
+        if (gd.getAmount() > 0) {
+            double price = gd.price();
+            auto [chpIt, inserted] = cheapestGoods.try_emplace(gd.getGoodId(), gd.getFullId(), price);
+            if (!inserted && price < chpIt->second.second) chpIt->second = {gd.getFullId(), price};
+        }
 }
 
 double Property::balance(std::vector<Good> &gds, const Property &tvlPpt, double &cst) const {
     // Set amounts of given goods such that they can be purchased for given cost, keeping ratios the
     // same. Adjusts cost downward and sets full ids, names, and measure words for goods.
     // Returns factor of actual amounts to ratios.
+    std::vector<double> prices;
+    prices.reserve(gds.size());
+    for (auto &gd : gds) {
+        auto chpIt = cheapestGoods.find(gd.getGoodId());
+        if (chpIt == end(cheapestGoods)) break;
+        auto chpst = good(chpIt->second.first);
+        gd.setFullId(chpst->getFullId());
+        gd.setFullName(chpst->getFullName());
+        gd.setMeasure(chpst->getMeasure());
+        prices.push_back(chpIt->second.second);
+    }
+    return balance(gds, prices, tvlPpt.amounts(), cst);
+}
+
+double Property::balance(std::vector<Good> &gds, const std::vector<double> &prcs,
+                         const std::unordered_map<unsigned int, double> &tvlAmts, double &cst) const {
+    // Balance goods already set to cheapest materials with given prices against given traveler amounts.
+    auto tvlAmount = [&tvlAmts](unsigned int gId) {
+        auto amtIt = tvlAmts.find(gId);
+        return amtIt == end(tvlAmts) ? 0. : amtIt->second;
+    };
     double factor = std::numeric_limits<double>::max();
     if (cst == 0) {
         // No goods can be bought.
-        for (auto &gd : goods) factor = std::min(tvlPpt.amount(gd.getGoodId()) / gd.getAmount(), factor);
+        for (auto &gd : goods) factor = std::min(tvlAmount(gd.getGoodId()) / gd.getAmount(), factor);
         gds.clear();
         return factor;
     }
-    double amountDotProduct = 0, ratioDotProduct = 0; // dot product of amounts and prices and prices and ratios
     size_t goodCount = gds.size();
+    if (prcs.size() < goodCount) /* A good is not available */
+        return 0;
+    double amountDotProduct = 0, ratioDotProduct = 0; // dot product of amounts and prices and prices and ratios
     std::vector<GoodBalance> goodBalances(goodCount);
     for (size_t i = 0; i < goodCount; ++i) {
         auto &gd = gds[i];
-        auto gdId = gd.getGoodId();
         auto &blnc = goodBalances[i];
-        blnc.amount = tvlPpt.amount(gdId);
+        blnc.amount = tvlAmount(gd.getGoodId());
         blnc.ratio = gd.getAmount();
-        std::tie(blnc.cheapest, blnc.price) = cheapest(gdId);
-        if (!blnc.cheapest) /* A good is not available */
-            return 0;
-        gd.setFullId(blnc.cheapest->getFullId());
-        gd.setFullName(blnc.cheapest->getFullName());
-        gd.setMeasure(blnc.cheapest->getMeasure());
+        blnc.cheapest = good(gd.getFullId());
+        blnc.price = prcs[i];
         amountDotProduct += blnc.amount * blnc.price;
         ratioDotProduct += blnc.ratio * blnc.price;
     }
@@ -174,61 +226,100 @@ double Property::balance(std::vector<Good> &gds, const Property &tvlPpt, double
     return factor;
 }
 
-BusinessPlan Property::businessPlan(const Business &bsn, const Property &tvlPpt, double ofVl, bool bld) const {
-    // Add a build plan for given business to given build plan vector if it can be built.
-    BusinessPlan plan{bsn};
+const PlanTemplate &Property::planTemplate(const Business &bsn, bool bld) const {
+    // Return the part of a plan for given business that depends only on this property, remaking it if prices
+    // have changed since it was last made.
+    auto &tmplt = planTemplates[{bsn.getId(), bsn.getMode(), bld}];
+    if (tmplt.epoch == priceEpoch) return tmplt;
+    tmplt.epoch = priceEpoch;
+    tmplt.available = false;
+    tmplt.profit = 0;
+    tmplt.request.clear();
+    tmplt.prices.clear();
     auto &requirements = bsn.getRequirements(), &inputs = bsn.getInputs(), &outputs = bsn.getOutputs();
-    plan.request.reserve(bld ? requirements.size() + inputs.size() : inputs.size());
+    tmplt.request.reserve(bld ? requirements.size() + inputs.size() : inputs.size());
     if (bld)
-        for (auto &rq : requirements) plan.request.push_back(rq);
+        for (auto &rq : requirements) tmplt.request.push_back(rq);
     double area = bsn.getArea();
-    plan.profit = 0;
+    for (auto &ip : inputs) {
+        tmplt.request.push_back(ip);
+        tmplt.request.back().setAmount(ip.getAmount() / area);
+    }
+    // Find cheapest material for each requested good.
+    size_t requestCount = tmplt.request.size(), inputStart = requestCount - inputs.size();
+    std::vector<double> prices(requestCount);
+    bool stocked = true; // whether all requested goods are available
+    for (size_t i = 0; i < requestCount; ++i) {
+        auto &gd = tmplt.request[i];
+        auto chpIt = cheapestGoods.find(gd.getGoodId());
+        if (chpIt == end(cheapestGoods)) {
+            if (i >= inputStart) /* An input is not available */
+                return tmplt;
+            stocked = false;
+            continue;
+        }
+        auto chpst = good(chpIt->second.first);
+        gd.setFullId(chpst->getFullId());
+        gd.setFullName(chpst->getFullName());
+        gd.setMeasure(chpst->getMeasure());
+        prices[i] = chpIt->second.second;
+    }
+    tmplt.available = true;
     unsigned int lastInputId;
     bool keepMaterial = bsn.getKeepMaterial();
-    for (auto &ip : inputs) {
-        plan.request.push_back(ip);
-        double amount = ip.getAmount() / area;
-        plan.request.back().setAmount(amount);
-        auto chpst = cheapest(ip.getGoodId());
-        if (!chpst.first) return {bsn, 0};
-        plan.profit -= amount * chpst.second;
-        if (keepMaterial) lastInputId = chpst.first->getMaterialId();
+    for (size_t i = inputStart; i < requestCount; ++i) {
+        auto &ip = tmplt.request[i];
+        tmplt.profit -= ip.getAmount() * prices[i];
+        if (keepMaterial) lastInputId = ip.getMaterialId();
+    }
+    // Leave prices empty if a requirement is unavailable so that balancing fails.
+    if (stocked) tmplt.prices = std::move(prices);
+    tmplt.profit = std::accumulate(begin(outputs), end(outputs), tmplt.profit,
+                                   [this, keepMaterial, lastInputId, area](double a, const Good &op) {
+                                       auto opId = op.getGoodId();
+                                       auto tnGd = good(boost::make_tuple(opId, keepMaterial ? lastInputId : opId));
+                                       if (!tnGd) return a;
+                                       return a + op.getAmount() / area * tnGd->price();
+                                   });
+    return tmplt;
+}
+
+std::vector<BusinessPlan> Property::plans(const Property &tvlPpt, const std::vector<Business> &bsns, double ofVl,
+                                          bool bld) const {
+    // Return plans for given businesses that can be carried out with given starting goods, ranked by profit less
+    // cost. Cheapest materials and traveler amounts are looked up once and shared by all plans.
+    auto travelerAmounts = tvlPpt.amounts();
+    std::vector<BusinessPlan> plans;
+    plans.reserve(bsns.size());
+    for (auto &bsn : bsns) {
+        auto &tmplt = planTemplate(bsn, bld);
+        if (!tmplt.available) continue;
+        double cost = ofVl;
+        BusinessPlan plan{bsn, 0, 0, tmplt.profit, tmplt.request, bld};
+        plan.factor = balance(plan.request, tmplt.prices, travelerAmounts, cost);
+        plan.cost = cost;
+        if (plan.factor > std::numeric_limits<double>::epsilon()) plans.push_back(std::move(plan));
     }
-    plan.profit = std::accumulate(begin(outputs), end(outputs), plan.profit,
-                                  [this, keepMaterial, lastInputId, area](double a, const Good &op) {
-                                      auto opId = op.getGoodId();
-                                      auto tnGd = good(boost::make_tuple(opId, keepMaterial ? lastInputId : opId));
-                                      if (!tnGd) return a;
-                                      return a + op.getAmount() / area * tnGd->price();
-                                  });
-    plan.factor = balance(plan.request, tvlPpt, ofVl);
-    plan.cost = ofVl;
-    plan.build = bld;
-    return plan;
+    // Rank plans by index since plans can't be assigned, keeping ties in order so the first best plan wins.
+    std::vector<size_t> order(plans.size());
+    std::iota(begin(order), end(order), 0);
+    std::stable_sort(begin(order), end(order), [&plans](size_t a, size_t b) {
+        return plans[a].profit - plans[a].cost > plans[b].profit - plans[b].cost;
+    });
+    std::vector<BusinessPlan> ranked;
+    ranked.reserve(plans.size());
+    for (auto i : order) ranked.push_back(std::move(plans[i]));
+    return ranked;
 }
 
 std::vector<BusinessPlan> Property::buildPlans(const Property &tvlPpt, double ofVl) const {
-    // Return vector of plans for businesses that can be built with given starting goods.
-    std::vector<BusinessPlan> buildable;
-    buildable.reserve(businesses.size());
-    for (auto &bsn : businesses) {
-        // Add build plan for all businesses.
-        auto plan = businessPlan(bsn, tvlPpt, ofVl, true);
-        if (plan.factor > std::numeric_limits<double>::epsilon()) buildable.push_back(plan);
-    }
-    return buildable;
+    // Return ranked vector of plans for businesses that can be built with given starting goods.
+    return plans(tvlPpt, businesses, ofVl, true);
 }
 
 std::vector<BusinessPlan> Property::restockPlans(const Property &tvlPpt, const Property &srgPpt, double ofVl) const {
-    // Return vector of plans for restocking businesses in given storage property with given starting goods.
-    std::vector<BusinessPlan> restockable;
-    auto &storageBusinesses = srgPpt.businesses;
-    restockable.reserve(storageBusinesses.size());
-    for (auto &bsn : storageBusinesses) {
-        auto plan = businessPlan(bsn, tvlPpt, ofVl, false);
-        if (plan.factor > std::numeric_limits<double>::epsilon()) restockable.push_back(plan);
-    }
-    return restockable;
+    // Return ranked vector of plans for restocking businesses in given storage property with given starting goods.
+    return plans(tvlPpt, srgPpt.businesses, ofVl, false);
 }
 
 double Property::totalValue(const Property &tvlPpt) const {
@@ -241,8 +332,10 @@ double Property::totalValue(const Property &tvlPpt) const {
 }
 
 void Property::setConsumption(const std::vector<std::array<double, 3>> &gdsCnsptn) {
+    ++priceEpoch;
     for (auto gdIt = begin(goods); gdIt != end(goods); ++gdIt)
         goods.modify(gdIt, [cnsptn = gdsCnsptn[gdIt->getFullId()]](auto &gd) { gd.setConsumption(cnsptn); });
+    refreshCheapest();
 }
 
 void Property::setFrequencies(const std::vector<double> &frqcs) {
@@ -251,6 +344,7 @@ void Property::setFrequencies(const std::vector<double> &frqcs) {
 
 void Property::setMaximums() {
     // Set maximum good amounts given businesses.
+    ++priceEpoch;
     for (auto gdIt = begin(goods); gdIt != end(goods); ++gdIt)
         goods.modify(gdIt, [](auto &gd) { gd.setMaximum(); });
     // Set good maximums for businesses.
@@ -278,6 +372,7 @@ void Property::setMaximums() {
     }
     for (auto gdIt = begin(goods); gdIt != end(goods); ++gdIt)
         goods.modify(gdIt, [](auto &gd) { gd.setDemandSlope(); });
+    refreshCheapest();
 }
 
 void Property::addGood(const Good &srGd, const std::function<void(Good &)> &fn) {
@@ -325,6 +420,7 @@ void Property::reset() {
 
 std::vector<Good> Property::take(unsigned int gId, double amt) {
     // Take away the given amount of the given good id, proportional among materials. Return transfer goods.
+    ++priceEpoch;
     auto &byGoodId = goods.get<GoodId>();
     auto gdRng = byGoodId.equal_range(gId);
     double total =
@@ -334,19 +430,23 @@ std::vector<Good> Property::take(unsigned int gId, double amt) {
         transfer.push_back(Good(gdIt->getFullId(), amt * gdIt->getAmount() / total));
         byGoodId.modify(gdIt, [&tG = transfer.back()](auto &gd) { gd.take(tG); });
     }
+    refreshCheapest(gId);
     return transfer;
 }
 
 void Property::take(Good &gd) {
     // Take the given good from this property.
+    ++priceEpoch;
     auto &byFullId = goods.get<FullId>();
     auto rGdIt = byFullId.find(gd.getFullId());
     if (rGdIt == end(byFullId)) return gd.use();
     byFullId.modify(rGdIt, [&gd](auto &rGd) { rGd.take(gd); });
+    refreshCheapest(rGdIt->getGoodId());
 }
 
 void Property::put(Good &gd) {
     // Put the given good in this property.
+    ++priceEpoch;
     auto fId = gd.getFullId();
     auto &byFullId = goods.get<FullId>();
     auto rGdIt = byFullId.find(fId);
@@ -356,10 +456,12 @@ void Property::put(Good &gd) {
         addGood(*source->good(fId), putGood);
     } else
         byFullId.modify(rGdIt, putGood);
+    refreshCheapest(good(fId)->getGoodId());
 }
 
 void Property::input(unsigned int ipId, double amt) {
     // Use the given amount of the given good id.
+    ++priceEpoch;
     auto &byGoodId = goods.get<GoodId>();
     auto gdRng = byGoodId.equal_range(ipId);
     double total =
@@ -367,15 +469,19 @@ void Property::input(unsigned int ipId, double amt) {
     if (total == 0) throw std::runtime_error("0 total using good " + std::to_string(ipId));
     auto useGood = [amt, total](auto &gd) { gd.use(amt * gd.getAmount() / total); };
     for (; gdRng.first != gdRng.second; ++gdRng.first) byGoodId.modify(gdRng.first, useGood);
+    refreshCheapest(ipId);
 }
 
 void Property::use() {
     // Use current amount of all goods.
+    ++priceEpoch;
     for (auto gdIt = begin(goods); gdIt != end(goods); ++gdIt) goods.modify(gdIt, [](auto &gd) { gd.use(); });
+    refreshCheapest();
 }
 
 void Property::output(unsigned int opId, double amt) {
     // Create the given amount of the lowest indexed material of the given good id.
+    ++priceEpoch;
     if (std::isnan(amt)) std::cout << opId;
     auto &byGoodId = goods.get<GoodId>();
     auto opRng = byGoodId.equal_range(opId);
@@ -386,10 +492,12 @@ void Property::output(unsigned int opId, double amt) {
         addGood(*std::min_element(srRng.first, srRng.second), createGood);
     } else
         byGoodId.modify(std::min_element(opRng.first, opRng.second), createGood);
+    refreshCheapest(opId);
 }
 
 void Property::output(unsigned int opId, unsigned int ipId, double amt) {
     // Create the given amount of the first good id based on inputs of the second good id.
+    ++priceEpoch;
     auto &byGoodId = goods.get<GoodId>();
     auto &byMaterialId = goods.get<MaterialId>();
     auto ipRng = byGoodId.equal_range(ipId);
@@ -416,9 +524,11 @@ void Property::output(unsigned int opId, unsigned int ipId, double amt) {
             // Create good.
             byMaterialId.modify(opIt, createGood);
     }
+    refreshCheapest(opId);
 }
 
 void Property::create(unsigned int fId, double amt) {
+    ++priceEpoch;
     auto createGood = [amt](auto &gd) { gd.create(amt); };
     auto &byFullId = goods.get<FullId>();
     auto gdIt = byFullId.find(fId);
@@ -426,12 +536,15 @@ void Property::create(unsigned int fId, double amt) {
         addGood(*source->good(fId), createGood);
     else
         byFullId.modify(gdIt, createGood);
+    refreshCheapest(good(fId)->getGoodId());
 }
 
 void Property::create() {
     // Create maximum amount of all goods.
+    ++priceEpoch;
     for (auto gdIt = begin(goods); gdIt != end(goods); ++gdIt)
         goods.modify(gdIt, [](auto &gd) { gd.create(); });
+    refreshCheapest();
 }
 
 void Property::build(const Business &bsn, double a) {
@@ -460,6 +573,7 @@ void Property::demolish(const Business &bsn, double a) {
 void Property::update(unsigned int elTm) {
     updateCounter += elTm;
     if (updateCounter > 0) {
+        ++priceEpoch;
         int updateTime = Settings::getPropertyUpdateTime();
         updateTime += updateCounter - updateCounter % updateTime;
         updateCounter -= updateTime;
@@ -470,6 +584,7 @@ void Property::update(unsigned int elTm) {
         // Update goods and run businesses for update time.
         auto updateGood = [updateTime, dayLength](Good &gd) { gd.update(updateTime, dayLength); };
         for (auto gdIt = begin(goods); gdIt != end(goods); ++gdIt) goods.modify(gdIt, updateGood);
+        refreshCheapest();
         std::unordered_map<unsigned int, Conflict> conflicts;
         for (auto &b : businesses)
             // Start by setting factor to business run time.
@@ -477,9 +592,17 @@ void Property::update(unsigned int elTm) {
         for (auto &b : businesses)
             // Handle conflicts on inputs by reducing factors.
             b.run(*this, conflicts);
+        historyTime += static_cast<unsigned int>(updateTime);
+        if (population) recordPrices();
     }
 }
 
+void Property::recordPrices() {
+    // Record amount and price of each good in price history after an update.
+    auto dayLength = static_cast<unsigned int>(Settings::getDayLength());
+    for (auto &gd : goods) priceHistories[gd.getFullId()].record(historyTime, gd.getAmount(), gd.price(), dayLength);
+}
+
 void Property::adjustAreas(const std::vector<MenuButton *> &rBs, double d) {
     d *= static_cast<double>(population) / 5000;
     for (auto &b : businesses) {
@@ -513,12 +636,15 @@ void Property::adjustAreas(const std::vector<MenuButton *> &rBs, double d) {
 }
 
 void Property::adjustDemand(const std::vector<MenuButton *> &rBs, double d) {
+    ++priceEpoch;
     d /= static_cast<double>(population) / 1000;
     auto &byFullId = goods.get<FullId>();
     for (auto &rB : rBs)
         if (rB->getClicked()) {
             std::string rBN = rB->getText()[0];
-            byFullId.modify(byFullId.find(rB->getId()), [d](auto &gd) { gd.adjustDemand(d); });
+            auto gdIt = byFullId.find(rB->getId());
+            byFullId.modify(gdIt, [d](auto &gd) { gd.adjustDemand(d); });
+            refreshCheapest(gdIt->getGoodId());
         }
 }
 
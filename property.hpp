@@ -19,7 +19,9 @@
 #ifndef PROPERTY_H
 #define PROPERTY_H
 
+#include <map>
 #include <numeric>
+#include <tuple>
 #include <unordered_map>
 #include <vector>
 
@@ -35,6 +37,7 @@ namespace mi = boost::multi_index;
 #include "business.hpp"
 #include "constants.hpp"
 #include "good.hpp"
+#include "pricehistory.hpp"
 
 struct Conflict {
     unsigned int count = 0; // number of businesses using the good
@@ -51,6 +54,8 @@ struct GoodBalance {
 
 struct BusinessPlan;
 
+struct PlanTemplate;
+
 class Property {
     using GdId = mi::const_mem_fun<Good, unsigned int, &Good::getGoodId>;
     using MtId = mi::const_mem_fun<Good, unsigned int, &Good::getMaterialId>;
@@ -60,6 +65,7 @@ class Property {
     using MtIdHsh = mi::hashed_unique<mi::tag<struct MaterialId>, mi::composite_key<Good, GdId, MtId>>;
     using FlIdHsh = mi::hashed_unique<mi::tag<struct FullId>, FlId>;
     using GoodContainer = boost::multi_index_container<Good, mi::indexed_by<FlIdOdr, GdIdHsh, MtIdHsh, FlIdHsh>>;
+    using CheapestTable = std::unordered_map<unsigned int, std::pair<unsigned int, double>>;
     TownType townType;
     bool coastal;
     unsigned long population;
@@ -68,7 +74,19 @@ class Property {
     int updateCounter;
     bool maxGoods = false;
     const Property *source = nullptr;
-    BusinessPlan businessPlan(const Business &bsn, const Property &tvlPpt, double ofVl, bool bld) const;
+    unsigned int priceEpoch = 1;            // incremented whenever goods change
+    CheapestTable cheapestGoods;            // full id and price of cheapest material in stock by good id
+    mutable std::map<std::tuple<unsigned int, unsigned int, bool>, PlanTemplate> planTemplates;
+    unsigned int historyTime = 0;                                  // game time recorded in price histories
+    std::unordered_map<unsigned int, PriceHistory> priceHistories; // price history of town's goods by full id
+    void recordPrices();
+    void refreshCheapest(unsigned int gId);
+    void refreshCheapest();
+    double balance(std::vector<Good> &gds, const std::vector<double> &prcs,
+                   const std::unordered_map<unsigned int, double> &tvlAmts, double &cst) const;
+    const PlanTemplate &planTemplate(const Business &bsn, bool bld) const;
+    std::vector<BusinessPlan> plans(const Property &tvlPpt, const std::vector<Business> &bsns, double ofVl,
+                                    bool bld) const;
     void addGood(const Good &srGd, const std::function<void(Good &)> &fn);
 
 public:
@@ -77,12 +95,15 @@ public:
         : coastal(ctl), population(0), updateCounter(Settings::propertyUpdateCounter()), source(src) {
     } // constructor for traveler
     Property(const std::vector<Good> &gds, const std::vector<Business> &bsns)
-        : goods(begin(gds), end(gds)), businesses(bsns) {}      // constructor for nation
+        : goods(begin(gds), end(gds)), businesses(bsns) {
+        refreshCheapest();
+    } // constructor for nation
     Property(const Save::Property *svPpt, const Property *src); // constructor for loading
     flatbuffers::Offset<Save::Property> save(flatbuffers::FlatBufferBuilder &b, unsigned int tId) const;
     TownType getTownType() const { return townType; }
     bool getCoastal() const { return coastal; }
     unsigned long getPopulation() const { return population; }
+    unsigned int getPriceEpoch() const { return priceEpoch; }
     const std::vector<Business> &getBusinesses() const { return businesses; }
     bool hasGood(unsigned int fId) const;
     const Good *good(unsigned int fId) const;
@@ -92,9 +113,11 @@ public:
     void forGood(const std::function<void(const Good &gd)> &fn) const;
     void forGood(unsigned int gId, const std::function<void(const Good &gd)> &fn) const;
     double amount(unsigned int gId) const;
+    std::unordered_map<unsigned int, double> amounts() const;
     double maximum(unsigned int gId) const;
     double weight() const;
     std::pair<const Good *, double> cheapest(unsigned int gId) const;
+    const PriceHistory *priceHistory(unsigned int fId) const;
     double balance(std::vector<Good> &gds, const Property &tvlPpt, double &cst) const;
     std::vector<BusinessPlan> buildPlans(const Property &tvlPpt, double ofVl) const;
     std::vector<BusinessPlan> restockPlans(const Property &tvlPpt, const Property &srgPpt, double ofVl) const;
@@ -0,0 +1,89 @@
+/*
+ * This file is part of Camels.
+ *
+ * Camels is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Camels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Camels.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * © Tom Rodgers notaraptor@gmail.com 2017-2019
+ */
+
+#include "routetable.hpp"
+
+#include "town.hpp"
+
+void RouteTable::build(std::vector<Town> &tns) {
+    // Store routes as compressed sparse rows with world lengths, then find shortest paths between all pairs of towns,
+    // splitting sources across hardware threads.
+    base = tns.data();
+    townCount = tns.size();
+    edgeOffsets.assign(1, 0);
+    edgeTowns.clear();
+    edgeLengths.clear();
+    for (auto &t : tns) {
+        for (auto nb : t.getNeighbors()) {
+            edgeTowns.push_back(static_cast<unsigned int>(index(nb)));
+            edgeLengths.push_back(t.getPosition().distance(nb->getPosition()));
+        }
+        edgeOffsets.push_back(edgeTowns.size());
+    }
+    distances.assign(townCount * townCount, unreachable);
+    nextHops.assign(townCount * townCount, none);
+    size_t threadCount = std::max(std::min(static_cast<size_t>(std::thread::hardware_concurrency()), townCount),
+                                  static_cast<size_t>(1));
+    std::vector<std::thread> threads;
+    threads.reserve(threadCount);
+    for (size_t t = 0; t < threadCount; ++t)
+        threads.emplace_back([this, t, threadCount] {
+            for (size_t src = t; src < townCount; src += threadCount) findPaths(src);
+        });
+    for (auto &thread : threads) thread.join();
+}
+
+size_t RouteTable::index(const Town *tn) const { return static_cast<size_t>(tn - base); }
+
+void RouteTable::findPaths(size_t src) {
+    // Run Dijkstra's algorithm from given source town, filling its row of distances and next hops.
+    double *rowDistances = distances.data() + src * townCount;
+    unsigned int *rowNextHops = nextHops.data() + src * townCount;
+    using Entry = std::pair<double, size_t>; // distance to town and index of town
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open;
+    rowDistances[src] = 0;
+    open.push({0, src});
+    while (!open.empty()) {
+        auto [dist, current] = open.top();
+        open.pop();
+        // Skip stale entries for towns already reached by a shorter path.
+        if (dist > rowDistances[current]) continue;
+        for (size_t e = edgeOffsets[current]; e < edgeOffsets[current + 1]; ++e) {
+            unsigned int nbIdx = edgeTowns[e];
+            double distT = dist + edgeLengths[e];
+            if (distT < rowDistances[nbIdx]) {
+                rowDistances[nbIdx] = distT;
+                // First hop from source is the neighbor itself, otherwise the first hop to the current town.
+                rowNextHops[nbIdx] = current == src ? nbIdx : rowNextHops[current];
+                open.push({distT, nbIdx});
+            }
+        }
+    }
+}
+
+Town *RouteTable::nextHop(const Town *frm, const Town *to) const {
+    // Return first town on shortest path between given towns, or null if there is none.
+    unsigned int hop = nextHops[index(frm) * townCount + index(to)];
+    return hop == none ? nullptr : base + hop;
+}
+
+double RouteTable::distance(const Town *frm, const Town *to) const {
+    // Return world distance along shortest path between given towns.
+    return distances[index(frm) * townCount + index(to)];
+}
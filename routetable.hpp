@@ -0,0 +1,56 @@
+/*
+ * This file is part of Camels.
+ *
+ * Camels is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Camels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Camels.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * © Tom Rodgers notaraptor@gmail.com 2017-2019
+ */
+
+#ifndef ROUTETABLE_H
+#define ROUTETABLE_H
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <span>
+#include <thread>
+#include <utility>
+#include <vector>
+
+class Town;
+
+class RouteTable {
+    Town *base = nullptr;               // first town of the town vector indexed by table
+    size_t townCount = 0;
+    std::vector<size_t> edgeOffsets;    // index in edge vectors of start of each town's row
+    std::vector<unsigned int> edgeTowns; // index of town at far end of each route, in rows by near town
+    std::vector<double> edgeLengths;    // world distance along each route, in rows by near town
+    std::vector<double> distances;      // world distance along shortest path between each pair of towns, by source row
+    std::vector<unsigned int> nextHops; // index of first town on shortest path between each pair, by source row
+    void findPaths(size_t src);
+
+public:
+    static constexpr double unreachable = std::numeric_limits<double>::infinity(); // distance between unlinked towns
+    static constexpr unsigned int none = std::numeric_limits<unsigned int>::max(); // next hop between unconnected towns
+    void build(std::vector<Town> &tns);
+    size_t index(const Town *tn) const;
+    std::span<const unsigned int> neighbors(size_t tIdx) const {
+        return {edgeTowns.data() + edgeOffsets[tIdx], edgeTowns.data() + edgeOffsets[tIdx + 1]};
+    }
+    Town *nextHop(const Town *frm, const Town *to) const;
+    double distance(const Town *frm, const Town *to) const;
+};
+
+#endif // ROUTETABLE_H
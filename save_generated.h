@@ -759,7 +759,9 @@ struct AI FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
   enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
     VT_DECISIONCOUNTER = 4,
     VT_DECISIONCRITERIA = 6,
-    VT_GOODSINFO = 8
+    VT_GOODSINFO = 8,
+    VT_ROLE = 10,
+    VT_ARCHETYPE = 12
   };
   int32_t decisionCounter() const {
     return GetField<int32_t>(VT_DECISIONCOUNTER, 0);
@@ -770,6 +772,12 @@ struct AI FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
   const flatbuffers::Vector<const GoodInfo *> *goodsInfo() const {
     return GetPointer<const flatbuffers::Vector<const GoodInfo *> *>(VT_GOODSINFO);
   }
+  uint32_t role() const {
+    return GetField<uint32_t>(VT_ROLE, 0);
+  }
+  int32_t archetype() const {
+    return GetField<int32_t>(VT_ARCHETYPE, -1);
+  }
   bool Verify(flatbuffers::Verifier &verifier) const {
     return VerifyTableStart(verifier) &&
            VerifyField<int32_t>(verifier, VT_DECISIONCOUNTER) &&
@@ -777,6 +785,8 @@ struct AI FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
            verifier.VerifyVector(decisionCriteria()) &&
            VerifyOffset(verifier, VT_GOODSINFO) &&
            verifier.VerifyVector(goodsInfo()) &&
+           VerifyField<uint32_t>(verifier, VT_ROLE) &&
+           VerifyField<int32_t>(verifier, VT_ARCHETYPE) &&
            verifier.EndTable();
   }
 };
@@ -793,6 +803,12 @@ struct AIBuilder {
   void add_goodsInfo(flatbuffers::Offset<flatbuffers::Vector<const GoodInfo *>> goodsInfo) {
     fbb_.AddOffset(AI::VT_GOODSINFO, goodsInfo);
   }
+  void add_role(uint32_t role) {
+    fbb_.AddElement<uint32_t>(AI::VT_ROLE, role, 0);
+  }
+  void add_archetype(int32_t archetype) {
+    fbb_.AddElement<int32_t>(AI::VT_ARCHETYPE, archetype, -1);
+  }
   explicit AIBuilder(flatbuffers::FlatBufferBuilder &_fbb)
         : fbb_(_fbb) {
     start_ = fbb_.StartTable();
@@ -809,8 +825,12 @@ inline flatbuffers::Offset<AI> CreateAI(
     flatbuffers::FlatBufferBuilder &_fbb,
     int32_t decisionCounter = 0,
     flatbuffers::Offset<flatbuffers::Vector<double>> decisionCriteria = 0,
-    flatbuffers::Offset<flatbuffers::Vector<const GoodInfo *>> goodsInfo = 0) {
+    flatbuffers::Offset<flatbuffers::Vector<const GoodInfo *>> goodsInfo = 0,
+    uint32_t role = 0,
+    int32_t archetype = -1) {
   AIBuilder builder_(_fbb);
+  builder_.add_archetype(archetype);
+  builder_.add_role(role);
   builder_.add_goodsInfo(goodsInfo);
   builder_.add_decisionCriteria(decisionCriteria);
   builder_.add_decisionCounter(decisionCounter);
@@ -821,14 +841,18 @@ inline flatbuffers::Offset<AI> CreateAIDirect(
     flatbuffers::FlatBufferBuilder &_fbb,
     int32_t decisionCounter = 0,
     const std::vector<double> *decisionCriteria = nullptr,
-    const std::vector<GoodInfo> *goodsInfo = nullptr) {
+    const std::vector<GoodInfo> *goodsInfo = nullptr,
+    uint32_t role = 0,
+    int32_t archetype = -1) {
   auto decisionCriteria__ = decisionCriteria ? _fbb.CreateVector<double>(*decisionCriteria) : 0;
   auto goodsInfo__ = goodsInfo ? _fbb.CreateVectorOfStructs<GoodInfo>(*goodsInfo) : 0;
   return Save::CreateAI(
       _fbb,
       decisionCounter,
       decisionCriteria__,
-      goodsInfo__);
+      goodsInfo__,
+      role,
+      archetype);
 }
 
 struct Traveler FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
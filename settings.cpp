@@ -29,7 +29,9 @@ EnumArray<BoxSize, BoxSizeType> Settings::boxSizes;
 int Settings::buttonMargin, Settings::goodButtonColumns, Settings::goodButtonRows,
     Settings::businessButtonColumns, Settings::businessButtonRows, Settings::dayLength;
 unsigned int Settings::townHeadStart;
-int Settings::propertyUpdateTime, Settings::travelersCheckTime, Settings::aIDecisionTime, Settings::aIBusinessInterval;
+int Settings::propertyUpdateTime, Settings::travelersCheckTime, Settings::aIDecisionTime, Settings::aIBusinessInterval,
+    Settings::aIDecisionBudget, Settings::aIDecisionAging;
+size_t Settings::aIDecisionsMax;
 double Settings::consumptionSpaceFactor, Settings::inputSpaceFactor, Settings::outputSpaceFactor;
 int Settings::minPriceDivisor;
 double Settings::townProfit;
@@ -39,13 +41,17 @@ int Settings::travelersMin;
 unsigned int Settings::statMax;
 int Settings::attackDistSq;
 double Settings::escapeChance;
+size_t Settings::logLength;
+bool Settings::logHistory;
 std::vector<std::pair<unsigned int, double>> Settings::playerStartingGoods;
 SDL_Color Settings::playerColor;
 EnumArray<double, AIRole> Settings::aIRoleWeights;
 EnumArray<AIStartingGoods, AIRole> Settings::aIStartingGoods;
 int Settings::aIDecisionCriteriaMax;
+size_t Settings::aIArchetypeCount;
+std::vector<std::shared_ptr<const EnumArray<double, DecisionCriteria>>> Settings::aIArchetypes;
 unsigned int Settings::aITownRange, Settings::aIGoodsCount;
-double Settings::aILimitFactorMin, Settings::aILimitFactorMax, Settings::aIAttackThreshold;
+double Settings::aILimitFactorMin, Settings::aILimitFactorMax, Settings::aIAttackThreshold, Settings::aIPlanTolerance;
 SDL_Color Settings::aIColor;
 std::mt19937 Settings::rng(std::chrono::high_resolution_clock::now().time_since_epoch().count());
 
@@ -136,6 +142,10 @@ void Settings::load(const fs::path &p) {
     travelersCheckTime = tree.get("time.travelersCheckTime", 4500);
     aIDecisionTime = tree.get("time.aIDecisionTime", 12000);
     aIBusinessInterval = tree.get("time.aIBusinessInterval", 20);
+    aIDecisionBudget = tree.get("time.aIDecisionBudget", 4000);
+    // At least one AI must be able to decide each frame.
+    aIDecisionsMax = std::max(static_cast<size_t>(tree.get("time.aIDecisionsMax", 64)), size_t{1});
+    aIDecisionAging = std::max(tree.get("time.aIDecisionAging", 1000), 1);
     consumptionSpaceFactor = tree.get("goods.consumptionSpaceFactor", 13.14);
     inputSpaceFactor = tree.get("goods.inputSpaceFactor", 19.71);
     outputSpaceFactor = tree.get("goods.outputSpaceFactor", 19.71);
@@ -148,10 +158,14 @@ void Settings::load(const fs::path &p) {
     statMax = static_cast<unsigned int>(tree.get("travelers.statMax", 15));
     attackDistSq = tree.get("travelers.attackDistSq", 9000);
     escapeChance = tree.get("travelers.escapeChance", 0.5);
+    // Log must hold at least the latest event, which also sets log page length.
+    logLength = std::max(static_cast<size_t>(tree.get("travelers.logLength", 64)), size_t{1});
+    logHistory = tree.get("player.logHistory", true);
     loadRange("player.startingGoods", std::back_inserter(playerStartingGoods), &loadPair<unsigned int, double>,
               std::vector<std::pair<unsigned int, double>>{{96, 0.75}, {100, 2.}}, tree);
     playerColor = loadColor("player.color", {255, 255, 255, 255}, tree);
     aIDecisionCriteriaMax = tree.get("aI.decisionCriteriaMax", 9);
+    aIArchetypeCount = tree.get("aI.archetypeCount", 0);
     loadRange("aI.roleWeights", begin(aIRoleWeights), std::vector<double>{0.4, 0.1, 0.1, 0.2, 0.1, 0.1}, tree);
     aIStartingGoods[AIRole::trader] =
         loadAIStartingGoods("aI.traderGoods", {2, {{1, 21.}, {2, 23.}, {16, 10.5}, {96, 0.75}, {100, 2.}}}, tree);
@@ -167,6 +181,7 @@ void Settings::load(const fs::path &p) {
     aILimitFactorMin = tree.get("aI.limitFactorMin", 0.1);
     aILimitFactorMax = tree.get("aI.limitFactorMax", 0.9);
     aIAttackThreshold = tree.get("aI.attackThreshold", 13500);
+    aIPlanTolerance = tree.get("aI.planTolerance", 0.2);
     aIColor = loadColor("ai.color", {191, 191, 191, 255}, tree);
 }
 
@@ -245,6 +260,9 @@ void Settings::save(const fs::path &p) {
     tree.put("time.travelersCheckTime", travelersCheckTime);
     tree.put("time.aIDecisionTime", aIDecisionTime);
     tree.put("time.aIBusinessInterval", aIBusinessInterval);
+    tree.put("time.aIDecisionBudget", aIDecisionBudget);
+    tree.put("time.aIDecisionsMax", aIDecisionsMax);
+    tree.put("time.aIDecisionAging", aIDecisionAging);
     tree.put("goods.consumptionSpaceFactor", consumptionSpaceFactor);
     tree.put("goods.inputSpaceFactor", inputSpaceFactor);
     tree.put("goods.outputSpaceFactor", outputSpaceFactor);
@@ -257,10 +275,13 @@ void Settings::save(const fs::path &p) {
     tree.put("travelers.statMax", statMax);
     tree.put("travelers.attackDistSq", attackDistSq);
     tree.put("travelers.escapeChance", escapeChance);
+    tree.put("travelers.logLength", logLength);
+    tree.put("player.logHistory", logHistory);
     saveRange("player.startingGoods", begin(playerStartingGoods), end(playerStartingGoods),
               &savePair<unsigned int, double>, tree);
     saveColor("player.color", playerColor, tree);
     tree.put("aI.decisionCriteriaMax", aIDecisionCriteriaMax);
+    tree.put("aI.archetypeCount", aIArchetypeCount);
     saveRange("aI.roleWeights", begin(aIRoleWeights), end(aIRoleWeights), tree);
     saveAIStartingGoods("aI.traderGoods", aIStartingGoods[AIRole::trader], tree);
     saveAIStartingGoods("aI.soldierGoods", aIStartingGoods[AIRole::soldier], tree);
@@ -273,6 +294,7 @@ void Settings::save(const fs::path &p) {
     tree.put("aI.limitFactorMin", aILimitFactorMin);
     tree.put("aI.limitFactorMax", aILimitFactorMax);
     tree.put("aI.attackThreshold", aIAttackThreshold);
+    tree.put("aI.planTolerance", aIPlanTolerance);
     saveColor("ui.aIColor", aIColor, tree);
     pt::write_ini(p.string(), tree);
 }
@@ -338,12 +360,41 @@ std::vector<unsigned int> Settings::aIFullIds(const std::vector<unsigned int> &f
     return randomChoice(fIds, aIGoodsCount);
 }
 
-EnumArray<double, DecisionCriteria> Settings::aIDecisionCriteria() {
-    // Randomize decision criteria.
+std::shared_ptr<const EnumArray<double, DecisionCriteria>> Settings::aIDecisionCriteria() {
+    // Randomize decision criteria, or pick one of a fixed set of randomized archetypes if archetype count is set.
     static std::uniform_real_distribution<double> dcCrtDis(1, aIDecisionCriteriaMax);
-    EnumArray<double, DecisionCriteria> dcCrt;
-    for (auto &dC : dcCrt) dC = dcCrtDis(rng);
-    return dcCrt;
+    auto randomCriteria = [] {
+        EnumArray<double, DecisionCriteria> dcCrt;
+        for (auto &dC : dcCrt) dC = dcCrtDis(rng);
+        return std::make_shared<const EnumArray<double, DecisionCriteria>>(dcCrt);
+    };
+    if (!aIArchetypeCount) return randomCriteria();
+    // Randomize archetypes which were not restored from a saved game.
+    aIArchetypes.resize(aIArchetypeCount);
+    for (auto &arch : aIArchetypes)
+        if (!arch) arch = randomCriteria();
+    std::uniform_int_distribution<size_t> archetypeDis(0, aIArchetypeCount - 1);
+    return aIArchetypes[archetypeDis(rng)];
+}
+
+std::shared_ptr<const EnumArray<double, DecisionCriteria>>
+Settings::aIDecisionCriteria(int arch, const EnumArray<double, DecisionCriteria> &dcCrt) {
+    // Return archetype with given index for a loaded AI, restoring it from given criteria if this is the first AI
+    // loaded with it, or given criteria alone if AI had no archetype.
+    if (arch < 0 || static_cast<size_t>(arch) >= aIArchetypeCount)
+        return std::make_shared<const EnumArray<double, DecisionCriteria>>(dcCrt);
+    aIArchetypes.resize(aIArchetypeCount);
+    auto &archetype = aIArchetypes[static_cast<size_t>(arch)];
+    if (!archetype) archetype = std::make_shared<const EnumArray<double, DecisionCriteria>>(dcCrt);
+    return archetype;
+}
+
+int Settings::aIArchetype(const EnumArray<double, DecisionCriteria> *dcCrt) {
+    // Return index of archetype with given decision criteria, or -1 if criteria are not an archetype's.
+    auto arIt =
+        std::find_if(begin(aIArchetypes), end(aIArchetypes), [dcCrt](auto &arch) { return arch.get() == dcCrt; });
+    if (arIt == end(aIArchetypes)) return -1;
+    return static_cast<int>(arIt - begin(aIArchetypes));
 }
 
 int Settings::aIDecisionCounter() {
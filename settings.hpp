@@ -21,6 +21,7 @@
 #define SETTINGS_H
 #include <chrono>
 #include <iostream>
+#include <memory>
 #include <random>
 #include <unordered_map>
 #include <unordered_set>
@@ -121,7 +122,10 @@ class Settings {
     static int propertyUpdateTime,     // time between business cycles in milliseconds
         travelersCheckTime,            // time between checks of dead travelers in milliseconds
         aIDecisionTime,                // time between AI cycles in milliseconds
-        aIBusinessInterval;            // cycles between AI business decisions
+        aIBusinessInterval,            // cycles between AI business decisions
+        aIDecisionBudget,              // time AI decisions may take each frame in microseconds
+        aIDecisionAging;               // time a due AI waits to rank as if it were half as far from player
+    static size_t aIDecisionsMax;      // number of AI decisions that may be made each frame
     static double consumptionSpaceFactor, inputSpaceFactor, outputSpaceFactor;
     static int minPriceDivisor;
     static double townProfit;
@@ -132,13 +136,17 @@ class Settings {
     static unsigned int statMax;
     static int attackDistSq;
     static double escapeChance;
+    static size_t logLength; // number of events kept in each traveler's log
+    static bool logHistory;  // whether player's older log events are spilled to a history file
     static std::vector<std::pair<unsigned int, double>> playerStartingGoods;
     static SDL_Color playerColor;
     static EnumArray<AIStartingGoods, AIRole> aIStartingGoods;
     static EnumArray<double, AIRole> aIRoleWeights;
     static int aIDecisionCriteriaMax;
+    static size_t aIArchetypeCount;
+    static std::vector<std::shared_ptr<const EnumArray<double, DecisionCriteria>>> aIArchetypes; // shared criteria
     static unsigned int aITownRange, aIGoodsCount;
-    static double aILimitFactorMin, aILimitFactorMax, aIAttackThreshold;
+    static double aILimitFactorMin, aILimitFactorMax, aIAttackThreshold, aIPlanTolerance;
     static SDL_Color aIColor;
     static std::mt19937 rng;
 
@@ -163,6 +171,9 @@ public:
     static int getTravelersCheckTime() { return travelersCheckTime; }
     static int getAIDecisionTime() { return aIDecisionTime; }
     static int getAIBusinessInterval() { return aIBusinessInterval; }
+    static int getAIDecisionBudget() { return aIDecisionBudget; }
+    static size_t getAIDecisionsMax() { return aIDecisionsMax; }
+    static int getAIDecisionAging() { return aIDecisionAging; }
     static double getConsumptionSpaceFactor() { return consumptionSpaceFactor; }
     static double getInputSpaceFactor() { return inputSpaceFactor; }
     static double getOutputSpaceFactor() { return outputSpaceFactor; }
@@ -175,6 +186,8 @@ public:
     static unsigned int getStatMax() { return statMax; }
     static int getAttackDistSq() { return attackDistSq; }
     static double getEscapeChance() { return escapeChance; }
+    static size_t getLogLength() { return logLength; }
+    static bool getLogHistory() { return logHistory; }
     static const std::vector<std::pair<unsigned int, double>> &getPlayerStartingGoods() {
         return playerStartingGoods;
     }
@@ -182,6 +195,7 @@ public:
     static int getAIDecisionCriteriaMax() { return aIDecisionCriteriaMax; }
     static unsigned int getAITownRange() { return aITownRange; }
     static double getAIAttackThreshold() { return aIAttackThreshold; }
+    static double getAIPlanTolerance() { return aIPlanTolerance; }
     static const SDL_Color &getAIColor() { return aIColor; }
     template <typename T> static T randomInt(T max) {
         // Return a random int less than or equal to max.
@@ -202,7 +216,11 @@ public:
     static AIRole aIRole();
     static std::vector<std::pair<unsigned int, double>> getAIStartingGoods(AIRole rl);
     static std::vector<unsigned int> aIFullIds(const std::vector<unsigned int> &fIds);
-    static EnumArray<double, DecisionCriteria> aIDecisionCriteria();
+    static std::shared_ptr<const EnumArray<double, DecisionCriteria>> aIDecisionCriteria();
+    static std::shared_ptr<const EnumArray<double, DecisionCriteria>>
+    aIDecisionCriteria(int arch, const EnumArray<double, DecisionCriteria> &dcCrt);
+    static int aIArchetype(const EnumArray<double, DecisionCriteria> *dcCrt);
+    static void clearAIArchetypes() { aIArchetypes.clear(); }
     static int aIDecisionCounter();
     static int aIBusinessCounter();
     static double aILimitFactor();
@@ -50,14 +50,98 @@ void Town::removeTraveler(const Traveler *t) {
     if (it != end(travelers)) travelers.erase(it);
 }
 
-Contract Town::takeBid(size_t idx) {
-    // Erase and return the bid with the given index.
-    auto bidIt = begin(bids) + idx;
-    auto bid = std::move(*bidIt);
-    bids.erase(bidIt);
+Contract Town::takeBid(Traveler *bdr) {
+    // Erase and return the bid placed by the given bidder.
+    auto &byBidder = bids.get<Bidder>();
+    auto bidIt = byBidder.find(bdr);
+    if (bidIt == end(byBidder)) throw std::runtime_error(bdr->getName() + " has no bid in " + getName());
+    auto bid = *bidIt;
+    byBidder.erase(bidIt);
     return bid;
 }
 
+void Town::addOrder(Order &&odr) { orders.push_back(std::move(odr)); }
+
+void Town::clearOrders() {
+    // Clear all orders placed since last clearing together at a uniform price for each good, so that the order
+    // travelers were updated in does not matter.
+    if (orders.empty()) return;
+    // Find net amount of each good coming into town.
+    std::unordered_map<unsigned int, double> netAmounts;
+    for (auto &odr : orders) {
+        for (auto &of : odr.offer) netAmounts[of.getFullId()] += of.getAmount();
+        for (auto &rq : odr.request) netAmounts[rq.getFullId()] -= rq.getAmount();
+    }
+    // Uniform price of each good is its price at midpoint of net change.
+    std::unordered_map<unsigned int, double> prices;
+    for (auto &nA : netAmounts) {
+        auto tnGd = property.good(nA.first);
+        prices[nA.first] = !tnGd ? 0 : nA.second == 0 ? tnGd->price() : tnGd->price(nA.second) / nA.second;
+    }
+    // Scale requests so that their value at uniform prices matches value of offers less town profit.
+    double townProfit = Settings::getTownProfit();
+    auto value = [&prices](double v, const Good &gd) { return v + prices[gd.getFullId()] * gd.getAmount(); };
+    std::unordered_map<unsigned int, double> requested, // total amount requested of each good
+        available;                                       // amount of each good in town once offers are put in
+    for (auto &odr : orders) {
+        double requestValue = std::accumulate(begin(odr.request), end(odr.request), 0., value);
+        double factor = requestValue == 0
+                            ? 1
+                            : std::accumulate(begin(odr.offer), end(odr.offer), 0., value) * townProfit / requestValue;
+        for (auto &rq : odr.request) {
+            double amount = rq.getAmount() * factor;
+            if (!rq.getSplit()) amount = floor(amount);
+            rq.setAmount(amount);
+            requested[rq.getFullId()] += amount;
+        }
+        for (auto &of : odr.offer) available[of.getFullId()] += of.getAmount();
+    }
+    // Find portion of each requested good that town can supply.
+    std::unordered_map<unsigned int, double> shares;
+    for (auto &rqd : requested) {
+        auto tnGd = property.good(rqd.first);
+        double amount = available[rqd.first] + (tnGd ? tnGd->getAmount() : 0);
+        shares[rqd.first] = rqd.second <= 0 ? 0 : std::min(amount / rqd.second, 1.);
+    }
+    // Share out requests in proportion to what is available and scale offers back to the value actually filled.
+    requested.clear();
+    for (auto &odr : orders) {
+        double requestValue = std::accumulate(begin(odr.request), end(odr.request), 0., value);
+        for (auto &rq : odr.request) {
+            double amount = rq.getAmount() * shares[rq.getFullId()];
+            if (!rq.getSplit()) amount = floor(amount);
+            rq.setAmount(amount);
+            requested[rq.getFullId()] += amount;
+        }
+        if (requestValue == 0) continue;
+        double filled = std::accumulate(begin(odr.request), end(odr.request), 0., value) / requestValue;
+        if (filled >= 1) continue;
+        for (auto &of : odr.offer) {
+            // Round unsplittable offers up so that town is not underpaid.
+            double amount = of.getAmount() * filled;
+            if (!of.getSplit()) amount = ceil(amount);
+            of.setAmount(amount);
+        }
+    }
+    // Gather offered goods from all travelers and put them in town at once.
+    auto &nationProperty = nation->getProperty();
+    Property offerPool(property.getCoastal(), &nationProperty), requestPool(property.getCoastal(), &nationProperty);
+    for (auto &odr : orders) odr.party->fillOffer(odr, offerPool);
+    offerPool.forGood([this](const Good &gd) {
+        Good pG(gd);
+        property.put(pG);
+    });
+    // Take requested goods for all travelers from town at once, leaving amounts lost to rounding in town.
+    for (auto &rqd : requested) {
+        if (rqd.second <= 0) continue;
+        Good tG(rqd.first, rqd.second);
+        property.take(tG);
+        if (tG.getAmount() > 0) requestPool.put(tG);
+    }
+    for (auto &odr : orders) odr.party->fillRequest(odr, requestPool, this);
+    orders.clear();
+}
+
 void Town::placeDot(std::vector<SDL_Rect> &drawn, const SDL_Point &ofs, double s) {
     // Place the dot for this town based on the given offset and scale.
     position.place(ofs, s);
@@ -76,6 +160,98 @@ void Town::draw(SDL_Renderer *s) {
     drawCircle(s, point, 3, dC, true);
 }
 
+void Town::setRegion(std::span<Town *const> rgn) {
+    // Set towns in region, discarding regional prices found for previous region.
+    region = rgn;
+    regionEpochs.clear();
+    regionRows.clear();
+    regionalPrices.clear();
+}
+
+const std::unordered_map<unsigned int, PriceRange> &Town::getRegionalPrices() const {
+    // Index minimum, maximum, and mean price of each good over region, updating only goods whose price changed in a
+    // region town since regional prices were last found.
+    regionEpochs.resize(region.size());
+    regionRows.resize(region.size());
+    // Full ids of goods with changed prices, and of those of them which lost their minimum or maximum price.
+    std::vector<unsigned int> changed, stale;
+    std::vector<std::pair<unsigned int, double>> row;
+    for (size_t i = 0; i < region.size(); ++i) {
+        unsigned int epoch = region[i]->property.getPriceEpoch();
+        if (regionEpochs[i] == epoch) continue;
+        regionEpochs[i] = epoch;
+        // Goods are visited in full id order, so rows stay sorted.
+        row.clear();
+        region[i]->property.forGood([&row](const Good &gd) { row.emplace_back(gd.getFullId(), gd.price()); });
+        auto &oldRow = regionRows[i];
+        auto oldIt = begin(oldRow);
+        auto newIt = begin(row);
+        while (oldIt != end(oldRow) || newIt != end(row)) {
+            if (newIt == end(row) || (oldIt != end(oldRow) && oldIt->first < newIt->first)) {
+                // Good is no longer in town, remove its old price.
+                auto &range = regionalPrices[oldIt->first];
+                range.total -= oldIt->second;
+                --range.count;
+                if (oldIt->second <= range.min || oldIt->second >= range.max) stale.push_back(oldIt->first);
+                changed.push_back(oldIt->first);
+                ++oldIt;
+            } else if (oldIt == end(oldRow) || newIt->first < oldIt->first) {
+                // Good is new to town, add its price.
+                auto &range = regionalPrices[newIt->first];
+                range.min = std::min(newIt->second, range.min);
+                range.max = std::max(newIt->second, range.max);
+                range.total += newIt->second;
+                ++range.count;
+                changed.push_back(newIt->first);
+                ++newIt;
+            } else {
+                if (oldIt->second != newIt->second) {
+                    // Price of good changed, replace old price with new.
+                    auto &range = regionalPrices[newIt->first];
+                    if (oldIt->second <= range.min || oldIt->second >= range.max) stale.push_back(newIt->first);
+                    range.min = std::min(newIt->second, range.min);
+                    range.max = std::max(newIt->second, range.max);
+                    range.total += newIt->second - oldIt->second;
+                    changed.push_back(newIt->first);
+                }
+                ++oldIt;
+                ++newIt;
+            }
+        }
+        oldRow.swap(row);
+    }
+    if (changed.empty()) return regionalPrices;
+    std::sort(begin(stale), end(stale));
+    stale.erase(std::unique(begin(stale), end(stale)), end(stale));
+    // Find range of goods which lost their minimum or maximum price again from rows of region towns.
+    for (auto fId : stale) {
+        auto &range = regionalPrices[fId];
+        if (!range.count) continue;
+        range = PriceRange();
+        for (auto &rgRow : regionRows) {
+            auto rwIt = std::lower_bound(begin(rgRow), end(rgRow), fId,
+                                         [](const std::pair<unsigned int, double> &gd, unsigned int f) {
+                                             return gd.first < f;
+                                         });
+            if (rwIt == end(rgRow) || rwIt->first != fId) continue;
+            range.min = std::min(rwIt->second, range.min);
+            range.max = std::max(rwIt->second, range.max);
+            range.total += rwIt->second;
+            ++range.count;
+        }
+    }
+    for (auto fId : changed) {
+        auto rgPrcIt = regionalPrices.find(fId);
+        if (rgPrcIt == end(regionalPrices)) continue;
+        if (rgPrcIt->second.count)
+            rgPrcIt->second.mean = rgPrcIt->second.total / rgPrcIt->second.count;
+        else
+            // No region town has good anymore.
+            regionalPrices.erase(rgPrcIt);
+    }
+    return regionalPrices;
+}
+
 void Town::update(unsigned int elTm) { property.update(elTm); }
 
 void Town::take(Good &g) { property.take(g); }
@@ -20,9 +20,12 @@
 #ifndef TOWN_H
 #define TOWN_H
 
+#include <limits>
 #include <map>
 #include <memory>
+#include <span>
 #include <string>
+#include <unordered_map>
 #include <utility>
 
 #include <SDL2/SDL.h>
@@ -30,6 +33,12 @@
 
 #include <sqlite3.h>
 
+#include <boost/multi_index/composite_key.hpp>
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/member.hpp>
+#include <boost/multi_index/ordered_index.hpp>
+#include <boost/multi_index_container.hpp>
+
 #include "business.hpp"
 #include "draw.hpp"
 #include "loadbar.hpp"
@@ -40,10 +49,34 @@
 
 struct GameData;
 class Nation;
-struct Contract;
+struct Order;
 class Traveler;
 
+struct Contract {
+    Traveler *party; // the other party to this contract, or this if contract is a bid
+    double owed;     // value holder will retain at end of contract
+    double wage;     // value holder earns daily, in deniers
+    AIRole role;     // role of employee under this contract
+};
+
+struct PriceRange {
+    double min = std::numeric_limits<double>::max(), max = 0, mean = 0; // of prices in region towns with good
+    double total = 0;                                                     // sum of prices in region towns with good
+    unsigned int count = 0;                                               // number of region towns with good
+};
+
 class Town {
+    using Party = mi::member<Contract, Traveler *, &Contract::party>;
+    using Wage = mi::member<Contract, double, &Contract::wage>;
+    using Role = mi::member<Contract, AIRole, &Contract::role>;
+    using WageOdr = mi::ordered_non_unique<mi::tag<struct WageOrder>, Wage>;
+    using RlWgOdr = mi::ordered_non_unique<mi::tag<struct RoleWageOrder>, mi::composite_key<Contract, Role, Wage>>;
+    using PtHsh = mi::hashed_unique<mi::tag<struct Bidder>, Party>;
+
+public:
+    using BidBook = boost::multi_index_container<Contract, mi::indexed_by<WageOdr, RlWgOdr, PtHsh>>;
+
+private:
     unsigned int id;
     const Nation *nation = nullptr;
     std::unique_ptr<TextBox> box;
@@ -51,7 +84,13 @@ class Town {
     Property property;
     std::vector<Town *> neighbors;
     std::vector<Traveler *> travelers;
-    std::vector<Contract> bids;
+    BidBook bids; // bids of travelers seeking employment, by wage, role and wage, and bidder
+    std::vector<Order> orders; // trades placed since orders were last cleared
+    std::span<Town *const> region;                  // towns within AI town range, nearest first
+    mutable std::vector<unsigned int> regionEpochs; // price epochs of region towns when regional prices were found
+    mutable std::vector<std::vector<std::pair<unsigned int, double>>> regionRows; // full ids and prices of goods of
+                                                                                   // region towns by full id
+    mutable std::unordered_map<unsigned int, PriceRange> regionalPrices; // price range in region by full id
 
 public:
     Town(unsigned int i, const std::vector<std::string> &nms, const Nation *nt, double lng, double lat,
@@ -67,12 +106,17 @@ public:
     const Property &getProperty() const { return property; }
     const std::vector<Town *> &getNeighbors() const { return neighbors; }
     const std::vector<Traveler *> &getTravelers() const { return travelers; }
-    const std::vector<Contract> &getBids() const { return bids; }
+    const BidBook &getBids() const { return bids; }
+    std::span<Town *const> getRegion() const { return region; }
+    const std::unordered_map<unsigned int, PriceRange> &getRegionalPrices() const;
+    void setRegion(std::span<Town *const> rgn);
     void clearTravelers() { travelers.clear(); }
     void removeTraveler(const Traveler *t);
     void addTraveler(Traveler *t) { travelers.push_back(t); }
-    Contract takeBid(size_t idx);
-    void addBid(const Contract &bd) { bids.push_back(bd); }
+    Contract takeBid(Traveler *bdr);
+    void addBid(const Contract &bd) { bids.insert(bd); }
+    void addOrder(Order &&odr);
+    void clearOrders();
     bool clickCaptured(const SDL_MouseButtonEvent &b) const { return box->clickCaptured(b); }
     void toggleMaxGoods() { property.toggleMaxGoods(); }
     void placeDot(std::vector<SDL_Rect> &drawn, const SDL_Point &ofs, double s);
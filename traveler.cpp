@@ -20,8 +20,8 @@
 #include "traveler.hpp"
 
 Traveler::Traveler(const std::string &n, Town *tn, const GameData &gD)
-    : name(n), nation(tn->getNation()), destination(tn), source(tn), home(nullptr), position(tn->getPosition()),
-      moving(false), portion(1), reputation(gD.nationCount), gameData(gD) {
+    : name(n), nameId(gD.names->intern(n)), nation(tn->getNation()), destination(tn), source(tn), home(nullptr),
+      position(tn->getPosition()), moving(false), portion(1), reputation(gD.nationCount), gameData(gD) {
     // Copy goods vector from nation.
     properties.emplace(std::piecewise_construct, std::forward_as_tuple(0),
                        std::forward_as_tuple(false, &tn->getNation()->getProperty()));
@@ -35,13 +35,14 @@ Traveler::Traveler(const std::string &n, Town *tn, const GameData &gD)
 }
 
 Traveler::Traveler(const Save::Traveler *ldTvl, const std::vector<Nation> &nts, std::vector<Town> &tns, const GameData &gD)
-    : name(ldTvl->name()->str()), nation(&nts[static_cast<size_t>(ldTvl->nation() - 1)]),
+    : name(ldTvl->name()->str()), nameId(gD.names->intern(name)),
+      nation(&nts[static_cast<size_t>(ldTvl->nation() - 1)]),
       destination(&tns[static_cast<size_t>(ldTvl->toTown() - 1)]),
       source(&tns[static_cast<size_t>(ldTvl->fromTown() - 1)]), home(nullptr),
       position(ldTvl->longitude(), ldTvl->latitude()), moving(ldTvl->moving()), portion(1), gameData(gD) {
     auto ldLog = ldTvl->log();
-    std::transform(ldLog->begin(), ldLog->end(), std::back_inserter(logText),
-                   [](auto ldL) { return ldL->str(); });
+    std::transform(ldLog->begin(), ldLog->end(), std::back_inserter(log),
+                   [](auto ldL) { return Event(ldL->str()); });
     // Copy good image pointers from nation's goods to traveler's goods.
     auto ntPpt = &nation->getProperty();
     auto ldProperties = ldTvl->properties();
@@ -56,12 +57,179 @@ Traveler::Traveler(const Save::Traveler *ldTvl, const std::vector<Nation> &nts,
     auto ldEquipment = ldTvl->equipment();
     std::transform(ldEquipment->begin(), ldEquipment->end(), std::back_inserter(equipment),
                    [](auto ldEq) { return Good(ldEq); });
+    auto ldAI = ldTvl->ai();
+    if (ldAI) aI = std::make_unique<AI>(*this, ldAI);
+}
+
+Traveler::~Traveler() {
+    gameData.travelerGrid->remove(this, gridCell);
+    gameData.encounters->cancel(this);
+}
+
+unsigned int NameTable::intern(const std::string &nm) {
+    // Return id of given name, adding it if new.
+    auto [idIt, added] = ids.emplace(nm, static_cast<unsigned int>(names.size()));
+    if (added) names.push_back(nm);
+    return idIt->second;
+}
+
+std::string Event::text(const GameData &gD, const Property &gdsPpt) const {
+    // Format this event as a sentence, looking up names and measures of goods in given property.
+    auto goodsText = [&gdsPpt](const LogGoods &gds) {
+        // Format entries of goods found in property first so that missing goods leave no separators.
+        std::vector<std::string> entries;
+        for (auto &gd : gds) {
+            auto srGd = gdsPpt.good(gd.first);
+            if (!srGd) continue;
+            Good lG(*srGd);
+            lG.setAmount(gd.second);
+            entries.push_back(lG.logEntry());
+        }
+        std::string gdsTx;
+        for (size_t i = 0; i < entries.size(); ++i) {
+            if (i) {
+                // This is not the first good.
+                if (entries.size() != 2) /* There are not exactly two goods. */
+                    gdsTx += ", ";
+                if (i + 1 == entries.size()) /* This is the last good. */
+                    gdsTx += " and ";
+            }
+            gdsTx += entries[i];
+        }
+        return gdsTx;
+    };
+    auto &actorName = gD.names->name(actor), &subjectName = gD.names->name(subject);
+    switch (type) {
+    case EventType::trade:
+        return actorName + " trades " + goodsText(given) + " for " + goodsText(received) + " in " + town->getName() +
+               ".";
+    case EventType::hire:
+        return actorName + " hires " + subjectName + " for " + goodsText(given) + ".";
+    case EventType::dismiss:
+        return actorName + " dismisses " + subjectName + " and collects " + goodsText(received) + ".";
+    case EventType::hit:
+        return actorName + "'s " + gD.names->name(weapon) + " strikes " + subjectName + ". " + subjectName + "'s " +
+               gD.partNames[part] + " has been " + gD.statusNames[status] + ".";
+    case EventType::arrival:
+        return actorName + " has arrived in the " +
+               gD.populationAdjectives.lower_bound(town->getProperty().getPopulation())->second + " " +
+               town->getNation()->getAdjective() + " " + gD.townTypeNames[town->getProperty().getTownType()] +
+               " of " + town->getName() + ".";
+    case EventType::catchUp:
+        return actorName + " catches up to " + subjectName + ".";
+    case EventType::escape:
+        return actorName + " has eluded " + subjectName + ".";
+    case EventType::mutualEscape:
+        return actorName + " and " + subjectName + " have eluded each other.";
+    case EventType::yield:
+        return actorName + " has yielded to " + subjectName + ".";
+    default:
+        return note;
+    }
+}
+
+void Traveler::startHistory(const fs::path &svPath, bool ld) {
+    // Spill log events older than log length to a history file for the game saved at given path, restoring the history
+    // saved with that game if loading so that histories of different games never mix.
+    auto stem = svPath.stem().string();
+    // Replace control characters and characters not allowed in file names.
+    const std::string unsafe = "<>:\"/\\|?*.";
+    std::replace_if(
+        begin(stem), end(stem),
+        [&unsafe](char c) { return static_cast<unsigned char>(c) < ' ' || unsafe.find(c) != std::string::npos; }, '_');
+    historyPath = "history";
+    fs::create_directory(historyPath);
+    historyPath /= stem;
+    historyPath.replace_extension("hist");
+    fs::remove(historyPath);
+    historyOffsets.clear();
+    historyEnd = 0;
+    auto savedPath = svPath;
+    savedPath.replace_extension("hist");
+    if (!ld || !fs::exists(savedPath)) return;
+    fs::copy_file(savedPath, historyPath);
+    // Index entries of restored history without reading their text.
+    std::ifstream file(historyPath.string(), std::ifstream::binary);
+    uint32_t length;
+    while (file.read(reinterpret_cast<char *>(&length), sizeof(length))) {
+        historyOffsets.push_back(historyEnd);
+        historyEnd += static_cast<std::streamoff>(sizeof(length) + length);
+        file.seekg(historyEnd);
+    }
+}
+
+void Traveler::saveHistory(const fs::path &svPath) const {
+    // Copy history file, if any, next to the game saved at given path.
+    if (historyPath.empty()) return;
+    auto savedPath = svPath;
+    savedPath.replace_extension("hist");
+    if (fs::exists(historyPath))
+        fs::copy_file(historyPath, savedPath, fs::copy_options::overwrite_existing);
+    else
+        fs::remove(savedPath);
+}
+
+void Traveler::logEvent(const Event &evt) {
+    // Add given event to log, spilling oldest events to history file, if any, once log is full.
+    log.push_back(evt);
+    size_t logLength = Settings::getLogLength();
+    if (log.size() <= logLength) return;
+    auto spillEnd = end(log) - static_cast<std::deque<Event>::difference_type>(logLength);
+    if (!historyPath.empty()) {
+        // Append spilled events as length-prefixed text, indexing their offsets.
+        std::ofstream file(historyPath.string(), std::ofstream::binary | std::ofstream::app);
+        auto &ntPpt = nation->getProperty();
+        for (auto evIt = begin(log); evIt != spillEnd; ++evIt) {
+            auto entry = evIt->text(gameData, ntPpt);
+            auto length = static_cast<uint32_t>(entry.size());
+            file.write(reinterpret_cast<const char *>(&length), sizeof(length));
+            file.write(entry.data(), length);
+            historyOffsets.push_back(historyEnd);
+            historyEnd += static_cast<std::streamoff>(sizeof(length) + length);
+        }
+    }
+    log.erase(begin(log), spillEnd);
+}
+
+std::vector<std::string> Traveler::logText(size_t first, size_t count) const {
+    // Format given count of log events, starting from given index counting from oldest history entry, as text. Only
+    // the requested page of the history file is read.
+    std::vector<std::string> text;
+    size_t last = std::min(first + count, logCount());
+    if (first >= last) return text;
+    text.reserve(last - first);
+    size_t historyCount = historyOffsets.size();
+    if (first < historyCount) {
+        std::ifstream file(historyPath.string(), std::ifstream::binary);
+        file.seekg(historyOffsets[first]);
+        uint32_t length;
+        size_t historyLast = std::min(last, historyCount);
+        for (size_t i = first; i < historyLast && file.read(reinterpret_cast<char *>(&length), sizeof(length)); ++i) {
+            std::string entry(length, '\0');
+            file.read(entry.data(), length);
+            text.push_back(std::move(entry));
+        }
+    }
+    auto &ntPpt = nation->getProperty();
+    for (size_t i = std::max(first, historyCount); i < last; ++i)
+        text.push_back(log[i - historyCount].text(gameData, ntPpt));
+    return text;
+}
+
+std::string Traveler::lastLogText() const {
+    // Format only the most recent log event as text.
+    if (log.empty()) return "";
+    return log.back().text(gameData, nation->getProperty());
 }
 
 flatbuffers::Offset<Save::Traveler> Traveler::save(flatbuffers::FlatBufferBuilder &b) const {
     // Return a flatbuffers save object for this traveler.
     auto svName = b.CreateString(name);
-    auto svLog = b.CreateVectorOfStrings(logText);
+    std::vector<std::string> logEntries;
+    logEntries.reserve(log.size());
+    auto &ntPpt = nation->getProperty();
+    for (auto &evt : log) logEntries.push_back(evt.text(gameData, ntPpt));
+    auto svLog = b.CreateVectorOfStrings(logEntries);
     std::vector<std::pair<unsigned int, Property>> vPpts(begin(properties), end(properties));
     auto svProperties = b.CreateVector<flatbuffers::Offset<Save::Property>>(
         properties.size(), [&b, &vPpts](size_t i) { return vPpts[i].second.save(b, vPpts[i].first); });
@@ -82,71 +250,12 @@ flatbuffers::Offset<Save::Traveler> Traveler::save(flatbuffers::FlatBufferBuilde
                                     svParts, svEquipment, 0, moving);
 }
 
-std::forward_list<Town *> Traveler::pathTo(const Town *tn) const {
-    // Return forward list of towns on shortest path to tn, excluding current town.
-    std::forward_list<Town *> path;
-    std::unordered_map<Town *, Town *> from;
-    // the town which each town can be most efficiently reached from
-    std::unordered_map<Town *, int> distSqTo({{destination, 0}});
-    // distance along route to each town
-    std::unordered_map<Town *, int> distSqEst({{destination, destination->distSq(tn)}});
-    // estimated distance along route through each town to goal
-    std::unordered_set<Town *> closed;
-    // set of towns already evaluated
-    auto shortest = [&distSqEst](Town *m, Town *n) {
-        int c = distSqEst[m], d = distSqEst[n];
-        if (c == d) return m->getId() < n->getId();
-        return c < d;
-    };
-    std::set<Town *, decltype(shortest)> open(shortest);
-    // set of discovered towns not yet evaluated sorted so that closest is first
-    open.insert(destination);
-    while (!open.empty()) {
-        // Find current town with lowest distance.
-        Town *current = *begin(open);
-        const std::vector<Town *> &neighbors = current->getNeighbors();
-        if (current == tn) {
-            // Current town is target town.
-            while (from.count(current)) {
-                path.push_front(current);
-                current = from[current];
-            }
-            return path;
-        }
-        open.erase(begin(open));
-        closed.insert(current);
-        for (auto &nb : neighbors) {
-            // Ignore town if already explored.
-            if (closed.count(nb)) continue;
-            // Find distance to nb through current.
-            int dSqT = distSqTo[current] + current->distSq(nb);
-            // Check if distance through current is less than previous shortest path to nb.
-            if (!distSqTo.count(nb) || dSqT < distSqTo[nb]) {
-                from[nb] = current;
-                distSqTo[nb] = dSqT;
-                distSqEst[nb] = dSqT + nb->distSq(tn);
-            }
-            // Add undiscovered node to open set.
-            if (!open.count(nb)) open.insert(nb);
-        }
-    }
-    // A path does not exist, return empty list.
-    return path;
-}
-
-int Traveler::pathDistSq(const Town *tn) const {
-    // Return the distance to tn along shortest path.
-    const std::forward_list<Town *> &path = pathTo(tn);
-    int distSq = 0;
-    const Town *m = destination;
-    for (auto &n : path) {
-        distSq += m->distSq(n);
-        m = n;
-    }
-    return distSq;
+double Traveler::pathDistance(const Town *tn) const {
+    // Return the world distance to tn along shortest path.
+    return gameData.routeTable->distance(destination, tn);
 }
 
-void Traveler::addToTown() { destination->addTraveler(this); }
+void Traveler::addToTown() { source->addTraveler(this); }
 
 bool Traveler::fightWon() const {
     // Returns true if there are enemies and none of them are alive and want to fight.
@@ -170,13 +279,16 @@ void Traveler::create(unsigned int fId, double amt) { properties.find(0)->second
 void Traveler::pickTown(const Town *tn) {
     // Start moving toward given town.
     if (weight() > 0 || moving) return;
-    const auto &path = pathTo(tn);
-    if (path.empty() || path.front() == destination) return;
-    destination = path.front();
+    // Step to first town on shortest path to given town.
+    auto hop = gameData.routeTable->nextHop(destination, tn);
+    if (!hop || hop == destination) return;
+    destination = hop;
     moving = true;
+    scheduleEncounters();
     forEmployee({AIRole::guard, AIRole::thug}, [this](Traveler *epl) {
         epl->destination = destination;
         epl->moving = true;
+        epl->scheduleEncounters();
     });
 }
 
@@ -206,12 +318,28 @@ void Traveler::clearTrade() {
 void Traveler::makeTrade() {
     if (offer.empty() || request.empty()) return;
     auto &ppt = properties.find(0)->second;
-    std::string logEntry = name + " trades ";
-    transfer(offer, ppt, *destination, logEntry);
-    logEntry += " for ";
-    transfer(request, *destination, ppt, logEntry);
-    logEntry += " in " + destination->getName() + ".";
-    logText.push_back(logEntry);
+    LogGoods given, received;
+    transfer(offer, ppt, *destination, given);
+    transfer(request, *destination, ppt, received);
+    logEvent({EventType::trade, nameId, nameId, destination, std::move(given), std::move(received)});
+}
+
+void Traveler::placeOrder() {
+    // Place current offer and request in town's order book, to be cleared with all other orders this update.
+    if (offer.empty() || request.empty()) return;
+    destination->addOrder({this, offer, request, {}});
+}
+
+void Traveler::fillOffer(Order &odr, Property &pl) {
+    // Move offered goods of given order from carried goods into given pool.
+    transfer(odr.offer, properties.find(0)->second, pl, odr.given);
+}
+
+void Traveler::fillRequest(Order &odr, Property &pl, const Town *tn) {
+    // Move requested goods of given order from given pool into carried goods and log the trade.
+    LogGoods received;
+    transfer(odr.request, pl, properties.find(0)->second, received);
+    logEvent({EventType::trade, nameId, nameId, tn, std::move(odr.given), std::move(received)});
 }
 
 void Traveler::divideExcess(double exc, double tnP) {
@@ -262,6 +390,15 @@ void Traveler::demolish(const Business &bsn, double a) {
     makeProperty(destination->getId()).demolish(bsn, a);
 }
 
+const std::pair<double, double> &Traveler::getEquipmentScores() const {
+    // Find attack and defense scores of equipment again only if equipment changed.
+    if (!equipmentScoresValid) {
+        equipmentScores = {AI::attackScore(equipment, stats), AI::defenseScore(equipment, stats)};
+        equipmentScoresValid = true;
+    }
+    return equipmentScores;
+}
+
 void Traveler::unequip(Part pt) {
     // Unequip all equipment using the given part id.
     auto unused = [pt](const Good &e) {
@@ -273,6 +410,7 @@ void Traveler::unequip(Part pt) {
     for (auto eI = uEI; eI != end(equipment); ++eI)
         if (eI->getAmount() > 0) properties.find(0)->second.put(*eI);
     equipment.erase(uEI, end(equipment));
+    equipmentScoresValid = false;
 }
 
 void Traveler::equip(Good &g) {
@@ -287,6 +425,7 @@ void Traveler::equip(Good &g) {
     properties.find(0)->second.take(g);
     // Put good in equipment container.
     equipment.push_back(g);
+    equipmentScoresValid = false;
 }
 
 void Traveler::equip(Part pt) {
@@ -310,28 +449,30 @@ void Traveler::equip(Part pt) {
                          nullptr);
         equipment.push_back(fist);
     }
+    equipmentScoresValid = false;
 }
 
 void Traveler::bid(double add, double wge) {
     // Add bid to current town with given addend and wage.
     contract = std::unique_ptr<Contract>(
-        new Contract{this, destination->getProperty().totalValue(properties.find(0)->second) + add, wge});
+        new Contract{this, destination->getProperty().totalValue(properties.find(0)->second) + add, wge,
+                     aI->getRole()});
     destination->addBid(*contract);
 }
 
-void Traveler::hire(size_t idx) {
-    // Hire the traveler with the given bid index.
-    auto bid = destination->takeBid(idx);
+void Traveler::hire(Traveler *bdr) {
+    // Hire the given traveler, taking their bid from the current town.
+    auto bid = destination->takeBid(bdr);
     auto employee = bid.party;
-    employees.insert({employee->aI->getRole(), employee});
+    employees.insert({bid.role, employee});
     bid.party = this;
     employee->contract = std::make_unique<Contract>(std::move(bid));
     auto &ppt = properties.find(0)->second, &eplPpt = employee->properties.find(0)->second;
-    std::string logEntry = name + " hires " + employee->name + " for ";
-    transfer(offer, ppt, eplPpt, logEntry);
-    logEntry += ".";
-    logText.push_back(logEntry);
-    employee->logText.push_back(logEntry);
+    LogGoods given;
+    transfer(offer, ppt, eplPpt, given);
+    Event event(EventType::hire, nameId, employee->nameId, destination, std::move(given), LogGoods());
+    logEvent(event);
+    employee->logEvent(event);
 }
 
 void Traveler::dismiss(Traveler *epl) {
@@ -352,30 +493,25 @@ void Traveler::dismiss(Traveler *epl) {
     for (auto townGood : townGoods)
         request.push_back(Good(townGood.first, townGood.second->quota(requestValue)));
     auto &ppt = properties.find(0)->second, &eplPpt = epl->properties.find(0)->second;
-    std::string logEntry = name + " dismisses " + epl->name + " and collects ";
-    transfer(request, eplPpt, ppt, logEntry);
-    logEntry += ".";
-    logText.push_back(logEntry);
-    epl->logText.push_back(logEntry);
+    LogGoods received;
+    transfer(request, eplPpt, ppt, received);
+    Event event(EventType::dismiss, nameId, epl->nameId, destination, LogGoods(), std::move(received));
+    logEvent(event);
+    epl->logEvent(event);
 }
 
 std::vector<Traveler *> Traveler::attackable() const {
-    // Get a vector of attackable travelers.
-    auto &forwardTravelers = source->getTravelers();       // travelers traveling from the same town
-    auto &backwardTravelers = destination->getTravelers(); // travelers traveling from the destination town
-    std::vector<Traveler *> able;
-    able.insert(end(able), begin(forwardTravelers), end(forwardTravelers));
-    if (source != destination) able.insert(end(able), begin(backwardTravelers), end(backwardTravelers));
-    if (!able.empty()) {
-        // Eliminate travelers which have reached town, are too far away, or are this traveler.
-        int aDstSq = Settings::getAttackDistSq();
-        able.erase(std::remove_if(begin(able), end(able),
-                                  [this, aDstSq](Traveler *tg) {
-                                      return tg->destination == tg->source ||
-                                             position.distSq(tg->position) > aDstSq || tg == this;
-                                  }),
-                   end(able));
-    }
+    // Get a vector of attackable travelers from moving travelers within attack distance.
+    auto able = gameData.travelerGrid->near(position, Settings::getAttackDistSq());
+    // Eliminate travelers which have reached town, are not traveling from the same or the destination town, are dead
+    // or already fighting, or are this traveler.
+    able.erase(std::remove_if(begin(able), end(able),
+                              [this](Traveler *tg) {
+                                  return tg->destination == tg->source ||
+                                         (tg->source != source && tg->source != destination) || tg->dead ||
+                                         !tg->enemies.empty() || tg == this;
+                              }),
+               end(able));
     return able;
 }
 
@@ -390,6 +526,20 @@ void Traveler::forEmployee(const std::vector<AIRole> &rls, const std::function<v
     for (auto rl : rls) { forEmployee(rl, fn); }
 }
 
+void Traveler::scheduleEncounters() {
+    // Predict when this traveler comes within attack distance of bandits waiting in its source town.
+    for (auto tvl : source->getTravelers()) {
+        if (tvl == this || tvl->moving || !tvl->aI || tvl->aI->getRole() != AIRole::bandit) continue;
+        double delay = EncounterQueue::meetDelay(position, destination->getPosition(), tvl->position);
+        if (std::isfinite(delay)) gameData.encounters->schedule(tvl, this, delay);
+    }
+}
+
+void Traveler::ambush(const std::vector<Traveler *> &tgts) {
+    // Let AI decide whether to attack one of travelers which came within attack distance.
+    if (aI) aI->ambush(tgts);
+}
+
 void Traveler::forAlly(const std::function<void(Traveler *)> &fn) {
     // Call given function on this traveler and all its allies.
     fn(this);
@@ -455,6 +605,14 @@ void Traveler::disengage() {
     }
     enemies.clear();
     allies.clear();
+    if (target && target->moving) {
+        // Remove target from traveler grid so that it can't be attacked again until it reaches a town.
+        gameData.travelerGrid->remove(target, target->gridCell);
+        target->sheltered = true;
+    }
+    if (aI && aI->getRole() == AIRole::bandit && !moving && alive())
+        // Ambush travelers which came within attack distance while this bandit was fighting.
+        for (auto tgt : attackable()) gameData.encounters->schedule(this, tgt, 0);
 }
 
 CombatHit Traveler::firstHit() {
@@ -464,7 +622,7 @@ CombatHit Traveler::firstHit() {
         for (auto &s : e.getCombatStats())
             for (size_t i = 0; i < defense.size(); ++i)
                 defense[static_cast<AttackType>(i)] += s.defense[static_cast<AttackType>(i)] * target->stats[s.stat];
-    CombatHit first = {std::numeric_limits<double>::max(), nullptr, ""};
+    CombatHit first = {std::numeric_limits<double>::max(), nullptr, 0};
     for (auto &e : equipment) {
         auto &ss = e.getCombatStats();
         if (ss.front().attack) {
@@ -481,13 +639,13 @@ CombatHit Traveler::firstHit() {
             double p = static_cast<double>(attack) / cO.hitChance / static_cast<double>(defense[type]);
             double time;
             if (p < 1)
-                time = (log(r) / log(1 - p) + 1) / speed;
+                time = (std::log(r) / std::log(1 - p) + 1) / speed;
             else
                 time = 1 / speed;
             if (time < first.time) {
                 first.time = time;
                 first.odd = &cO;
-                first.weapon = e.getFullName();
+                first.weapon = gameData.names->intern(e.getFullName());
             }
         }
     }
@@ -587,11 +745,9 @@ void Traveler::hit() {
     if (status > Status::wounded)
         // Part is too wounded to hold equipment.
         target->unequip(part);
-    std::string logEntry = name + "'s " + nextHit->weapon + " strikes " + target->name + ". " + target->name +
-                           "'s " + gameData.partNames[part] + " has been " + gameData.statusNames[status] +
-                           ".";
-    logText.push_back(logEntry);
-    target->logText.push_back(logEntry);
+    Event event(nameId, target->nameId, nextHit->weapon, part, status);
+    logEvent(event);
+    target->logEvent(event);
     nextHit = nullptr;
 }
 
@@ -631,6 +787,18 @@ void Traveler::startAI(const Traveler &p) {
     aI = std::make_unique<AI>(*this, *p.aI);
 }
 
+bool Traveler::decisionDue() const { return aI && aI->decisionDue(); }
+
+int Traveler::decisionWait() const { return aI->decisionWait(); }
+
+AIRole Traveler::getAIRole() const { return aI->getRole(); }
+
+void Traveler::refreshNearby() {
+    if (aI) aI->refreshNearby();
+}
+
+void Traveler::decide(TownQuotes &qts) { aI->decide(qts); }
+
 void Traveler::update(unsigned int elTm) {
     // Move traveler toward destination, update properties, and perform combat with target.
     if (aI) aI->update(elTm);
@@ -643,16 +811,16 @@ void Traveler::update(unsigned int elTm) {
             source->removeTraveler(this);
             source = destination;
             destination->addTraveler(this);
-            logText.push_back(
-                name + " has arrived in the " +
-                gameData.populationAdjectives.lower_bound(destination->getProperty().getPopulation())->second +
-                " " + destination->getNation()->getAdjective() + " " +
-                gameData.townTypeNames[destination->getProperty().getTownType()] + " of " +
-                destination->getName() + ".");
-        }
+            gameData.travelerGrid->remove(this, gridCell);
+            sheltered = false;
+            if (aI && aI->getRole() == AIRole::bandit)
+                // Ambush travelers already within attack distance of this town.
+                for (auto tgt : attackable()) gameData.encounters->schedule(this, tgt, 0);
+            logEvent({nameId, destination});
+        } else if (!sheltered)
+            gameData.travelerGrid->place(this, position, gridCell);
     }
     for (auto enemy : enemies) {
-        std::string logEntry;
         switch (enemy->choice) {
         case FightChoice::fight:
             fight(elTm);
@@ -665,28 +833,29 @@ void Traveler::update(unsigned int elTm) {
                     // Enemy is caught, fight.
                     enemy->choice = FightChoice::fight;
                     fight(elTm);
-                    logEntry = name + " catches up to " + enemy->name + ".";
-                    logText.push_back(logEntry);
-                    enemy->logText.push_back(logEntry);
+                    Event event(EventType::catchUp, nameId, enemy->nameId);
+                    logEvent(event);
+                    enemy->logEvent(event);
                 } else {
                     // Enemy escapes.
-                    logEntry = enemy->name + " has eluded " + name + ".";
-                    logText.push_back(logEntry);
-                    enemy->logText.push_back(logEntry);
+                    Event event(EventType::escape, enemy->nameId, nameId);
+                    logEvent(event);
+                    enemy->logEvent(event);
                     enemy->disengage();
                 }
             } else {
-                logEntry = name + " and " + enemy->name + " have eluded each other.";
-                logText.push_back(logEntry);
-                enemy->logText.push_back(logEntry);
+                Event event(EventType::mutualEscape, nameId, enemy->nameId);
+                logEvent(event);
+                enemy->logEvent(event);
                 enemy->disengage();
             }
             break;
-        case FightChoice::yield:
-            logEntry = enemy->name + " has yielded to " + name + ".";
-            logText.push_back(logEntry);
-            enemy->logText.push_back(logEntry);
+        case FightChoice::yield: {
+            Event event(EventType::yield, enemy->nameId, nameId);
+            logEvent(event);
+            enemy->logEvent(event);
             break;
+        }
         default:
             break;
         }
@@ -718,18 +887,12 @@ void Traveler::adjustDemand(const std::vector<TextBox *> &bxs, double mM) {
 }
 
 template <class Source, class Destination>
-void transfer(std::vector<Good> &gds, Source &src, Destination &dst, std::string &lgEt) {
-    // Transfer goods from source to destination and append to log entry.
-    for (auto gI = begin(gds); gI != end(gds); ++gI) {
-        if (gI != begin(gds)) {
-            // This is not the first good.
-            if (gds.size() != 2) /* There are not exactly two goods. */
-                lgEt += ", ";
-            if (gI + 1 == end(gds)) /* This is the last good. */
-                lgEt += " and ";
-        }
-        src.take(*gI);
-        dst.put(*gI);
-        lgEt += gI->logEntry();
+void transfer(std::vector<Good> &gds, Source &src, Destination &dst, LogGoods &lgGds) {
+    // Transfer goods from source to destination and record them for log.
+    lgGds.reserve(lgGds.size() + gds.size());
+    for (auto &gd : gds) {
+        src.take(gd);
+        dst.put(gd);
+        lgGds.emplace_back(gd.getFullId(), gd.getAmount());
     }
 }
@@ -23,12 +23,15 @@
 #include <algorithm>
 #include <array>
 #include <cmath>
-#include <forward_list>
+#include <deque>
+#include <fstream>
 #include <functional>
 #include <limits>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include <SDL2/SDL.h>
@@ -36,6 +39,7 @@
 #include "ai.hpp"
 #include "constants.hpp"
 #include "draw.hpp"
+#include "encounters.hpp"
 #include "enum_array.hpp"
 #include "good.hpp"
 #include "menubutton.hpp"
@@ -44,7 +48,9 @@
 #include "selectbutton.hpp"
 #include "settings.hpp"
 #include "textbox.hpp"
+#include "routetable.hpp"
 #include "town.hpp"
+#include "travelergrid.hpp"
 
 enum class Status { normal, bruised, wounded, broken, infected, pulverized, amputated, impaled, count };
 
@@ -53,6 +59,19 @@ struct CombatOdd {
     std::array<std::pair<Status, double>, kStatusChanceCount> statusChances;
 };
 
+class ArbitrageTable;
+
+struct TownQuotes;
+
+class NameTable {
+    std::vector<std::string> names;                    // names by id
+    std::unordered_map<std::string, unsigned int> ids; // ids by name
+
+public:
+    unsigned int intern(const std::string &nm);
+    const std::string &name(unsigned int id) const { return names[id]; }
+};
+
 struct GameData {
     unsigned int nationCount, townCount;
     EnumArray<std::string, Part> partNames;
@@ -60,25 +79,62 @@ struct GameData {
     EnumArray<CombatOdd, AttackType> odds;
     EnumArray<std::string, TownType> townTypeNames;
     std::map<unsigned long, std::string> populationAdjectives;
+    const ArbitrageTable *arbitrage = nullptr; // best trade route for each good across all towns
+    const RouteTable *routeTable = nullptr;    // shortest paths between all pairs of towns
+    TravelerGrid *travelerGrid = nullptr;      // moving travelers by position
+    EncounterQueue *encounters = nullptr;      // predicted ambushes of moving travelers by time
+    NameTable *names = nullptr;                // traveler and weapon names referenced by log events
 };
 
 struct CombatHit {
     double time;
     const CombatOdd *odd;
-    std::string weapon;
+    unsigned int weapon; // name id of weapon
 };
 
 enum class FightChoice { none = -1, fight, run, yield, count };
 
+enum class EventType { note, trade, hire, dismiss, hit, arrival, catchUp, escape, mutualEscape, yield };
+
+using LogGoods = std::vector<std::pair<unsigned int, double>>; // full ids and amounts of goods in an event
+
+struct Event {
+    EventType type;
+    unsigned int actor = 0, subject = 0; // name ids of acting traveler and traveler acted upon
+    std::string note;                    // text of a note
+    const Town *town = nullptr;          // town event happened in
+    LogGoods given, received;            // goods given and received by actor
+    unsigned int weapon = 0;             // name id of weapon that hit
+    Part part = Part::head;              // part that was hit
+    Status status = Status::normal;      // status of part that was hit
+    Event(const std::string &nt) : type(EventType::note), note(nt) {} // constructor for notes
+    Event(EventType tp, unsigned int act, unsigned int sbj)
+        : type(tp), actor(act), subject(sbj) {} // constructor for fight outcomes
+    Event(unsigned int act, const Town *tn)
+        : type(EventType::arrival), actor(act), town(tn) {} // constructor for arrivals
+    Event(EventType tp, unsigned int act, unsigned int sbj, const Town *tn, LogGoods &&gvn, LogGoods &&rcvd)
+        : type(tp), actor(act), subject(sbj), town(tn), given(std::move(gvn)), received(std::move(rcvd)) {
+    } // constructor for trades, hires, and dismissals
+    Event(unsigned int act, unsigned int sbj, unsigned int wpn, Part pt, Status st)
+        : type(EventType::hit), actor(act), subject(sbj), weapon(wpn), part(pt), status(st) {} // constructor for hits
+    std::string text(const GameData &gD, const Property &gdsPpt) const;
+};
+
 class AI;
 
 struct Contract;
 
+struct Order;
+
 class Traveler {
     std::string name;
+    unsigned int nameId; // id of name in game's name table
     const Nation *nation;
     Town *destination, *source, *home;
-    std::vector<std::string> logText;
+    std::deque<Event> log; // most recent events, up to log length
+    fs::path historyPath;  // file older events are spilled to, if any
+    std::vector<std::streamoff> historyOffsets; // offset of each entry in history file
+    std::streamoff historyEnd = 0;              // size of history file
     Position position; // coordinates of traveler in world
     bool moving;
     double portion;                                        // portion of goods offered in next trade
@@ -88,6 +144,9 @@ class Traveler {
     EnumArray<unsigned int, Stat> stats;
     EnumArray<Status, Part> parts;
     std::vector<Good> equipment;
+    mutable std::pair<double, double> equipmentScores; // attack and defense scores of equipment with stats
+    mutable bool equipmentScoresValid = false;         // false if equipment changed since scores were found
+    size_t gridCell = TravelerGrid::npos;              // index of cell in traveler grid while moving
     std::unordered_multimap<AIRole, Traveler *> employees; // travelers employed by role
     std::unique_ptr<Contract> contract;                    // contract with employer, if any
     std::unordered_set<Traveler *> enemies, allies;        // travelers currently fighting
@@ -96,25 +155,30 @@ class Traveler {
     std::unique_ptr<CombatHit> nextHit;                    // next hit on target
     double fightTime;                                      // time left to fight this round
     FightChoice choice;
-    bool dead = false; // true if traveler is not alive and not being looted from
+    bool dead = false;      // true if traveler is not alive and not being looted from
+    bool sheltered = false; // true if traveler lost a fight and can't be attacked again until it reaches a town
     std::unique_ptr<AI> aI;
     const GameData &gameData;
-    std::forward_list<Town *> pathTo(const Town *t) const;
-    int pathDistSq(const Town *t) const;
+    double pathDistance(const Town *t) const;
     Property &makeProperty(unsigned int tId);
     void forEmployee(AIRole rl, const std::function<void(Traveler *)> &fn);
     void forEmployee(const std::vector<AIRole> &rls, const std::function<void(Traveler *)> &fn);
     void clearCombat();
+    void logEvent(const Event &evt);
 
 public:
     Traveler(const std::string &n, Town *t, const GameData &gD);
     Traveler(const Save::Traveler *ldTvl, const std::vector<Nation> &nts, std::vector<Town> &tns, const GameData &gD);
+    ~Traveler();
     flatbuffers::Offset<Save::Traveler> save(flatbuffers::FlatBufferBuilder &b) const;
     std::string getName() const { return name; }
     const Town *town() const { return destination; }
     const Town *getHome() const { return home; }
     const Nation *getNation() const { return nation; }
-    const std::vector<std::string> &getLogText() const { return logText; }
+    const std::deque<Event> &getLog() const { return log; }
+    size_t logCount() const { return historyOffsets.size() + log.size(); }
+    std::vector<std::string> logText(size_t first, size_t count) const;
+    std::string lastLogText() const;
     const Property &property() const { return properties.find(0)->second; }
     const Property *property(unsigned int tId) const {
         auto pptIt = properties.find(tId);
@@ -127,6 +191,7 @@ public:
     double speed() const { return stats[Stat::strength] + stats[Stat::endurance] + stats[Stat::agility]; }
     Status part(Part pt) const { return parts[pt]; }
     const std::vector<Good> &getEquipment() const { return equipment; }
+    const std::pair<double, double> &getEquipmentScores() const;
     const Contract *getContract() const { return contract.get(); }
     Traveler *getTarget() const { return target; }
     unsigned int getTargeterCount() const { return targeterCount; }
@@ -144,11 +209,14 @@ public:
     }
     bool fightWon() const;
     void setHome() { home = destination; }
+    void startHistory(const fs::path &svPath, bool ld);
+    void saveHistory(const fs::path &svPath) const;
     void choose(FightChoice c) { choice = c; }
     void setPortion(double p);
     void changePortion(double d);
     void addToTown();
     void create(unsigned int fId, double amt);
+    const GameData &getGameData() const { return gameData; }
     void pickTown(const Town *tn);
     void place(const SDL_Point &ofs, double s) { position.place(ofs, s); }
     void draw(SDL_Renderer *s) const;
@@ -160,6 +228,9 @@ public:
     void updatePortionBox(TextBox *bx) const;
     void divideExcess(double exc, double tnP);
     void makeTrade();
+    void placeOrder();
+    void fillOffer(Order &odr, Property &pl);
+    void fillRequest(Order &odr, Property &pl, const Town *tn);
     BoxInfo boxInfo(const SDL_Rect &rt, const std::vector<std::string> &tx, BoxSizeType sz, BoxBehavior bvr,
                     SDL_Keycode ky, const std::function<void(MenuButton *)> &fn) const {
         return Settings::boxInfo(rt, tx, nation->getColors(), {0, false}, sz, bvr, ky, fn);
@@ -184,9 +255,11 @@ public:
     void equip(Good &g);
     void equip(Part pt);
     void bid(double bns, double wge);
-    void hire(size_t idx);
+    void hire(Traveler *bdr);
     void dismiss(Traveler *epl);
     std::vector<Traveler *> attackable() const;
+    void scheduleEncounters();
+    void ambush(const std::vector<Traveler *> &tgts);
     void forAlly(const std::function<void(Traveler *)> &fn);
     void forCombatant(const std::function<void(Traveler *)> &fn);
     void attack(Traveler *tgt);
@@ -204,6 +277,11 @@ public:
     void createAIGoods(AIRole rl);
     void startAI();
     void startAI(const Traveler &p);
+    bool decisionDue() const;
+    int decisionWait() const;
+    AIRole getAIRole() const;
+    void decide(TownQuotes &qts);
+    void refreshNearby();
     void update(unsigned int e);
     void toggleMaxGoods();
     void resetTown();
@@ -211,13 +289,13 @@ public:
     void adjustDemand(const std::vector<TextBox *> &bxs, double mM);
 };
 
-struct Contract {
-    Traveler *party; // the other party to this contract, or this if contract is a bid
-    double owed;     // value holder will retain at end of contract
-    double wage;     // value holder earns daily, in deniers
+struct Order {
+    Traveler *party;                  // the traveler who placed this order
+    std::vector<Good> offer, request; // goods offered to and requested from town
+    LogGoods given;                   // goods given while order is filled
 };
 
 template <class Source, class Destination>
-void transfer(std::vector<Good> &gds, Source &src, Destination &dst, std::string &lgEt);
+void transfer(std::vector<Good> &gds, Source &src, Destination &dst, LogGoods &lgGds);
 
 #endif // TRAVELER_H
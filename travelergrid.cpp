@@ -0,0 +1,65 @@
+/*
+ * This file is part of Camels.
+ *
+ * Camels is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Camels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Camels.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * © Tom Rodgers notaraptor@gmail.com 2017-2019
+ */
+#include "travelergrid.hpp"
+
+TravelerGrid::TravelerGrid()
+    : cellSize(std::max(std::sqrt(Settings::getAttackDistSq()) / Settings::getScale(), 0.1)),
+      columns(static_cast<size_t>(std::ceil(360 / cellSize))), rows(static_cast<size_t>(std::ceil(180 / cellSize))),
+      cells(columns * rows) {}
+
+size_t TravelerGrid::column(double lng) const {
+    return std::min(static_cast<size_t>(std::max((lng + 180) / cellSize, 0.)), columns - 1);
+}
+
+size_t TravelerGrid::row(double ltt) const {
+    return std::min(static_cast<size_t>(std::max((ltt + 90) / cellSize, 0.)), rows - 1);
+}
+
+void TravelerGrid::place(Traveler *tvl, const Position &pos, size_t &cll) {
+    // Move given traveler to cell containing given position, if it has changed cells.
+    size_t target = row(pos.getLatitude()) * columns + column(pos.getLongitude());
+    if (target == cll) return;
+    remove(tvl, cll);
+    cells[target].push_back({tvl, &pos});
+    cll = target;
+}
+
+void TravelerGrid::remove(Traveler *tvl, size_t &cll) {
+    // Remove given traveler from its cell, if any.
+    if (cll == npos) return;
+    auto &cell = cells[cll];
+    auto etIt = std::find_if(begin(cell), end(cell), [tvl](const GridEntry &et) { return et.traveler == tvl; });
+    if (etIt != end(cell)) {
+        *etIt = cell.back();
+        cell.pop_back();
+    }
+    cll = npos;
+}
+
+std::vector<Traveler *> TravelerGrid::near(const Position &pos, int dstSq) const {
+    // Find travelers within given squared distance on screen of given position, checking only cells in range.
+    double range = (std::sqrt(dstSq) + 2) / Settings::getScale(); // distance in degrees, padded for rounding
+    size_t columnEnd = column(pos.getLongitude() + range), rowEnd = row(pos.getLatitude() + range);
+    std::vector<Traveler *> found;
+    for (size_t r = row(pos.getLatitude() - range); r <= rowEnd; ++r)
+        for (size_t c = column(pos.getLongitude() - range); c <= columnEnd; ++c)
+            for (auto &et : cells[r * columns + c])
+                if (pos.distSq(*et.position) <= dstSq) found.push_back(et.traveler);
+    return found;
+}
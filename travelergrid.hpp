@@ -0,0 +1,51 @@
+/*
+ * This file is part of Camels.
+ *
+ * Camels is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Camels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Camels.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * © Tom Rodgers notaraptor@gmail.com 2017-2019
+ */
+#ifndef TRAVELERGRID_H
+#define TRAVELERGRID_H
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "draw.hpp"
+#include "settings.hpp"
+
+class Traveler;
+
+struct GridEntry {
+    Traveler *traveler;
+    const Position *position;
+};
+
+class TravelerGrid {
+    double cellSize;                           // width and height of each cell in degrees
+    size_t columns, rows;                      // number of cells across longitude and latitude
+    std::vector<std::vector<GridEntry>> cells; // travelers in each cell, by row then column
+    size_t column(double lng) const;
+    size_t row(double ltt) const;
+
+public:
+    static constexpr size_t npos = std::numeric_limits<size_t>::max(); // cell index of travelers not in grid
+    TravelerGrid();
+    void place(Traveler *tvl, const Position &pos, size_t &cll);
+    void remove(Traveler *tvl, size_t &cll);
+    std::vector<Traveler *> near(const Position &pos, int dstSq) const;
+};
+
+#endif // TRAVELERGRID_H